@@ -70,6 +70,8 @@ class ParserTongueConan(ConanFile):
     
     def package_info(self):
         self.cpp_info.libs = ["parsertongue"]
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs = ["pthread"]
     
     def generate(self):
         base = self.python_requires["pyreq"].module.BaseConan
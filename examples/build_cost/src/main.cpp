@@ -0,0 +1,44 @@
+// Compiled once including the headers and once importing the module, to compare the cost of both. The standard
+// headers are included in both cases, so that the difference is only the cost of the library.
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef BUILD_COST_MODULE
+import parsertongue;
+#else
+#include "parsertongue/parser.h"
+#endif
+
+int main(int argc, char** argv)
+{
+    auto       parser  = pt::parser(argc, argv);
+    const auto verbose = parser.add_flag('v', "verbose");
+    const auto count   = parser.add_value<int32_t>('c', "count");
+    const auto ratio   = parser.add_value<double>('r', "ratio");
+    const auto name    = parser.add_value<std::string>('n', "name");
+    const auto files   = parser.add_list<std::string>('f', "files");
+    const auto ids     = parser.add_list<int64_t>('i', "ids");
+    count->set_default(1);
+    ratio->set_default(0.5);
+
+    std::string e;
+    if (!parser(e))
+    {
+        std::cout << e << std::endl;
+        return 1;
+    }
+    if (!parser.get_errors().empty())
+    {
+        parser.display_errors(std::cout);
+        return 1;
+    }
+
+    if (verbose->is_set()) std::cout << count->get_value() << ' ' << ratio->get_value() << std::endl;
+    if (name->is_set()) std::cout << name->get_value() << std::endl;
+    if (files->is_set())
+        for (const auto& f : files->get_values()) std::cout << f << std::endl;
+    if (ids->is_set())
+        for (const auto i : ids->get_values()) std::cout << i << std::endl;
+    return 0;
+}
@@ -0,0 +1,33 @@
+################################################################################
+# Compiler launcher that runs the compile command REPEAT times and prints the
+# fastest run. Invoked as:
+# cmake -DLABEL=<label> -DREPEAT=<n> -P time_compile.cmake -- <command...>
+################################################################################
+
+set(COMMAND)
+set(FOUND_SEPARATOR FALSE)
+math(EXPR LAST "${CMAKE_ARGC} - 1")
+foreach(I RANGE ${LAST})
+    if (FOUND_SEPARATOR)
+        list(APPEND COMMAND "${CMAKE_ARGV${I}}")
+    elseif ("${CMAKE_ARGV${I}}" STREQUAL "--")
+        set(FOUND_SEPARATOR TRUE)
+    endif()
+endforeach()
+
+set(BEST "")
+foreach(I RANGE 1 ${REPEAT})
+    string(TIMESTAMP START "%s%f")
+    execute_process(COMMAND ${COMMAND} RESULT_VARIABLE RESULT)
+    string(TIMESTAMP END "%s%f")
+    if (NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "${LABEL}: compilation failed")
+    endif()
+
+    math(EXPR ELAPSED "(${END} - ${START}) / 1000")
+    if (BEST STREQUAL "" OR ELAPSED LESS BEST)
+        set(BEST ${ELAPSED})
+    endif()
+endforeach()
+
+message(STATUS "${LABEL}: ${BEST} ms (fastest of ${REPEAT})")
@@ -0,0 +1,94 @@
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+#include "parsertongue/parser.h"
+#include "parsertongue/recorder.h"
+
+namespace
+{
+    /**
+     * \brief Add the arguments of the application. Recording and replaying must use the same arguments.
+     */
+    void add_arguments(pt::parser& parser)
+    {
+        parser.add_flag('a', "longName");
+        parser.add_flag('b');
+        parser.add_value<int32_t>('x', "valueX")->add_options(10, 100, 1000);
+        parser.add_value<float>('y')->set_default(33.33f);
+        parser.add_list<std::string>('f', "filenames");
+        parser.add_list<double>('d', "doubles");
+    }
+
+    int usage()
+    {
+        std::cout << "Usage:\n"
+                     "  replay_benchmark record <log> [arguments...]  Parse the arguments and append them to the log\n"
+                     "  replay_benchmark replay <log> [iterations]    Replay the log and print a JSON report\n";
+        return 2;
+    }
+
+    int record(const char* path, const int argc, char** argv)
+    {
+        auto parser = pt::parser(argc, argv, true);
+        add_arguments(parser);
+
+        const auto  rec = std::make_shared<pt::recorder>(path);
+        std::string e;
+        parser.set_recorder(rec);
+        if (!rec->open(e))
+        {
+            std::cout << e << std::endl;
+            return 1;
+        }
+
+        if (!parser(e))
+        {
+            std::cout << "Internal parsing error: " << e << std::endl;
+            return 1;
+        }
+        if (!parser.get_errors().empty()) parser.display_errors(std::cout);
+
+        if (!rec->flush(e))
+        {
+            std::cout << e << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    int replay(const char* path, const char* iterations_arg)
+    {
+        size_t iterations = 1;
+        if (iterations_arg)
+        {
+            const auto* end      = iterations_arg + std::strlen(iterations_arg);
+            const auto [ptr, ec] = std::from_chars(iterations_arg, end, iterations);
+            if (ec != std::errc() || ptr != end || iterations == 0) return usage();
+        }
+
+        pt::recording log;
+        std::string   e;
+        if (!pt::read_recording(path, log, e))
+        {
+            std::cout << e << std::endl;
+            return 1;
+        }
+
+        auto parser = pt::parser(0, nullptr, true);
+        add_arguments(parser);
+        const auto report = pt::replay(parser, log, iterations);
+        std::cout << report.to_json() << std::endl;
+
+        // Outcomes that differ from the recording are behavior changes.
+        return report.mismatches.empty() ? 0 : 1;
+    }
+}  // namespace
+
+int main(const int argc, char** argv)
+{
+    if (argc < 3) return usage();
+    if (std::strcmp(argv[1], "record") == 0) return record(argv[2], argc - 3, argv + 3);
+    if (std::strcmp(argv[1], "replay") == 0 && argc <= 4) return replay(argv[2], argc == 4 ? argv[3] : nullptr);
+    return usage();
+}
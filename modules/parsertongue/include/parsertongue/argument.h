@@ -4,19 +4,60 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/fingerprint.h"
+#include "parsertongue/parse_error.h"
+
 namespace pt
 {
+    class column_batch;
+    class constraints;
+    class option_file;
+    class option_snapshot;
     class parser;
+    class recorder;
+    class telemetry;
+
+    /**
+     * \brief Immutable snapshot of the parsed state of an argument.
+     */
+    class argument_state
+    {
+    public:
+        virtual ~argument_state() = default;
+    };
+
+    using argument_state_ptr = std::shared_ptr<const argument_state>;
+
+    /**
+     * \brief Where the value of an argument came from.
+     */
+    enum class value_source : uint32_t
+    {
+        none,
+        command_line,
+        environment
+    };
 
     class argument
     {
     public:
+        friend class column_batch;
+        friend class constraints;
+        friend class option_file;
+        friend class option_snapshot;
         friend class parser;
+        friend class recorder;
+        friend class telemetry;
 
         argument() = delete;
 
@@ -44,11 +85,98 @@ namespace pt
 
         void add_relevant_argument(argument& arg, bool required);
 
+        /**
+         * \brief Bind this argument to an environment variable. When the user did not pass the argument on the
+         * command line, the value is read from the variable instead. Flags are enabled by the values 1, true, yes
+         * and on.
+         * \param name Name of the environment variable. Overrides the name derived from the parser's prefix.
+         */
+        void set_env(std::string name);
+
+        /**
+         * \brief Get where the value of this argument came from.
+         * \return Source.
+         */
+        [[nodiscard]] value_source get_source() const noexcept;
+
+        /**
+         * \brief Include or exclude this argument from the fingerprint of the parser. Exclude arguments that do not
+         * affect the output of your application, such as verbosity. Enabled by default.
+         * \param enabled If true, the value of this argument is part of the fingerprint.
+         */
+        void set_fingerprint(bool enabled);
+
         virtual void reset() = 0;
 
     protected:
         [[nodiscard]] std::string get_pretty_name() const;
 
+        /**
+         * \brief Describe why a string could not be converted to the value of this argument.
+         * \param error Conversion error.
+         * \param str String that failed to convert.
+         * \return Message.
+         */
+        [[nodiscard]] std::string get_conversion_message(conversion_error error, const std::string& str) const;
+
+        /**
+         * \brief Create a snapshot of the parsed state.
+         * \return State.
+         */
+        [[nodiscard]] virtual argument_state_ptr save() const = 0;
+
+        /**
+         * \brief Restore the parsed state from a snapshot that was created by save.
+         * \param state State.
+         */
+        virtual void restore(const argument_state& state) = 0;
+
+        /**
+         * \brief Check if the user passed this argument. Unlike is_set, this ignores defaults.
+         * \return True if the argument was passed.
+         */
+        [[nodiscard]] virtual bool has_value() const noexcept = 0;
+
+        /**
+         * \brief Parse the value of the bound environment variable.
+         * \param arg Value of the variable.
+         * \param parse_errors List of errors.
+         */
+        virtual void parse_env(const std::string& arg, std::vector<parse_error_t>& parse_errors) = 0;
+
+        /**
+         * \brief Get the hash of the parsed value. Only meaningful if has_value returns true.
+         * \return Fingerprint.
+         */
+        [[nodiscard]] virtual fingerprint get_fingerprint() const noexcept = 0;
+
+        /**
+         * \brief Run all validators on the parsed values.
+         * \param parse_errors List of errors.
+         */
+        virtual void validate(std::vector<parse_error_t>& parse_errors) const;
+
+        /**
+         * \brief Index of this argument in the order of registration with the parser.
+         */
+        size_t index = 0;
+
+        /**
+         * \brief If true, this argument is set by an operand at a fixed position and long_name is its display name.
+         */
+        bool positional = false;
+
+        value_source source = value_source::none;
+
+        std::string env_name;
+
+        bool fingerprinted = true;
+
+        /**
+         * \brief What this argument currently adds to the fingerprint of the parser.
+         */
+        fingerprint contribution;
+
         char        short_name = '\0';
         std::string long_name;
         std::string short_help;
@@ -0,0 +1,396 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/argument.h"
+#include "parsertongue/list.h"
+#include "parsertongue/parsable.h"
+#include "parsertongue/parser_tongue_exception.h"
+#include "parsertongue/parse_error.h"
+#include "parsertongue/string_pool.h"
+#include "parsertongue/validator.h"
+#include "parsertongue/value.h"
+
+namespace pt
+{
+    class parser;
+
+    namespace detail
+    {
+        /**
+         * \brief Storage for the arguments created by parser::bind and friends. Arguments are placed in a monotonic
+         * buffer instead of being allocated one by one, and live as long as the arena.
+         */
+        class argument_arena
+        {
+        public:
+            argument_arena() = default;
+
+            argument_arena(const argument_arena&) = delete;
+
+            argument_arena(argument_arena&&) = delete;
+
+            ~argument_arena() noexcept
+            {
+                for (auto it = objects.rbegin(); it != objects.rend(); ++it) (*it)->~argument();
+            }
+
+            argument_arena& operator=(const argument_arena&) = delete;
+
+            argument_arena& operator=(argument_arena&&) = delete;
+
+            template<typename A, typename... Args>
+            A* create(Args&&... args)
+            {
+                void* p = resource.allocate(sizeof(A), alignof(A));
+                auto* a = new (p) A(std::forward<Args>(args)...);
+                objects.push_back(a);
+                return a;
+            }
+
+        private:
+            std::pmr::monotonic_buffer_resource resource;
+            std::pmr::vector<argument*>         objects{&resource};
+        };
+    }  // namespace detail
+
+    template<parsable T>
+    class bound_value_state final : public argument_state
+    {
+    public:
+        bound_value_state(std::optional<T> v, const fingerprint digest) : v(std::move(v)), digest(digest) {}
+
+        const std::optional<T> v;
+        const fingerprint      digest;
+    };
+
+    /**
+     * \brief Value that converts directly into storage owned by the caller. The contents of the storage when the
+     * value was bound act as its default.
+     */
+    template<parsable T>
+    class bound_value final : public base_value
+    {
+    public:
+        bound_value() = delete;
+
+        bound_value(const bound_value&) = delete;
+
+        bound_value(bound_value&&) = delete;
+
+        bound_value(const char short_name, std::string long_name, T& target) :
+            base_value(short_name, std::move(long_name)), target(&target), initial(target)
+        {
+        }
+
+        ~bound_value() noexcept override = default;
+
+        bound_value& operator=(const bound_value&) = delete;
+
+        bound_value& operator=(bound_value&&) = delete;
+
+        /**
+         * \brief Check if the user passed the value. Throws an exception if the parser was not run yet.
+         * \return True if the value was set, false otherwise.
+         */
+        [[nodiscard]] bool is_set() const
+        {
+            if (!valid) throw_exception("Cannot retrieve value before running the parser");
+            return set;
+        }
+
+        /**
+         * \brief Limit the number of allowed values to all options that are added through this method.
+         * \param value Value to add.
+         */
+        void add_option(T value) { options.emplace_back(std::move(value)); }
+
+        /**
+         * \brief Limit the number of allowed values to all options that are added through this method.
+         * \tparam Ts T.
+         * \param values Values to add.
+         */
+        template<std::same_as<T>... Ts>
+        void add_options(Ts... values)
+        {
+            (add_option(std::move(values)), ...);
+        }
+
+        /**
+         * \brief Add a validator that is run on the value after parsing. Failures are reported as validation_failed
+         * errors, but the value remains set.
+         * \param v Validator.
+         */
+        void add_validator(validator<T> v) { validators.emplace_back(std::move(v)); }
+
+        void reset() override
+        {
+            base_value::reset();
+            if (set) *target = initial;
+            set    = false;
+            digest = {};
+        }
+
+    protected:
+        [[nodiscard]] argument_state_ptr save() const override
+        {
+            return std::make_shared<bound_value_state<T>>(set ? std::optional<T>(*target) : std::nullopt, digest);
+        }
+
+        void restore(const argument_state& state) override
+        {
+            const auto& s = static_cast<const bound_value_state<T>&>(state);
+            *target       = s.v ? *s.v : initial;
+            set           = s.v.has_value();
+            digest        = s.digest;
+        }
+
+        [[nodiscard]] bool has_value() const noexcept override { return set; }
+
+        [[nodiscard]] fingerprint get_fingerprint() const noexcept override { return digest; }
+
+        void validate(std::vector<parse_error_t>& parse_errors) const override
+        {
+            if (!set) return;
+
+            std::vector<validation_failure> failures;
+            for (const auto& validator : validators) validator(std::span<const T>(target, 1), failures);
+            for (auto& f : failures)
+            {
+                std::string str;
+                if constexpr (std::is_convertible_v<const T&, std::string>)
+                    str = *target;
+                else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+                    str = std::string_view(*target);
+                parse_errors.emplace_back(parse_error::validation_failed,
+                                          std::move(str),
+                                          std::format("{0}: {1}", get_pretty_name(), f.message));
+            }
+        }
+
+        void parse(const std::string& arg, std::vector<parse_error_t>& parse_errors) noexcept override
+        {
+            auto val = detail::parse_value<T>(arg, pool);
+
+            // If there is a limited number of allowed options, check if the passed value is valid.
+            if (val && !options.empty() && std::find(options.cbegin(), options.cend(), *val) == options.end())
+                val = std::unexpected(conversion_error::invalid_option);
+
+            if (val)
+            {
+                digest  = detail::hash_value(*val, arg);
+                *target = std::move(*val);
+                set     = true;
+            }
+            else
+                parse_errors.emplace_back(parse_error::parsing_error, arg, get_conversion_message(val.error(), arg));
+        }
+
+    private:
+        T*                        target;
+        T                         initial;
+        bool                      set = false;
+        std::vector<T>            options;
+        std::vector<validator<T>> validators;
+        fingerprint               digest;
+    };
+
+    /**
+     * \brief Containers that bound lists can append to.
+     */
+    template<typename C>
+    concept appendable = parsable<typename C::value_type> && requires(C& c, typename C::value_type v)
+    {
+        c.push_back(std::move(v));
+        c.erase(c.begin(), c.end());
+        {
+            c.size()
+            } -> std::convertible_to<size_t>;
+    };
+
+    template<appendable C>
+    class bound_list_state final : public argument_state
+    {
+    public:
+        using hasher_t = std::conditional_t<range_parsable<typename C::value_type>,
+                                            detail::sequence_hasher<typename C::value_type>,
+                                            fingerprint_hasher>;
+
+        bound_list_state(std::vector<typename C::value_type> values, const hasher_t& hasher) :
+            values(std::move(values)), hasher(hasher)
+        {
+        }
+
+        const std::vector<typename C::value_type> values;
+        const hasher_t                            hasher;
+    };
+
+    /**
+     * \brief List that appends directly to a container owned by the caller. Elements that were in the container when
+     * the list was bound are kept. Integral lists accept the range syntax first-last[:step], but ranges are expanded.
+     */
+    template<appendable C>
+    class bound_list final : public base_list
+    {
+    public:
+        using value_type = typename C::value_type;
+
+        bound_list() = delete;
+
+        bound_list(const bound_list&) = delete;
+
+        bound_list(bound_list&&) = delete;
+
+        bound_list(const char short_name, std::string long_name, C& target) :
+            base_list(short_name, std::move(long_name)), target(&target), initial_size(target.size())
+        {
+        }
+
+        ~bound_list() noexcept override = default;
+
+        bound_list& operator=(const bound_list&) = delete;
+
+        bound_list& operator=(bound_list&&) = delete;
+
+        /**
+         * \brief Check if the user passed any elements. Throws an exception if the parser was not run yet.
+         * \return True if the list was set, false otherwise.
+         */
+        [[nodiscard]] bool is_set() const
+        {
+            if (!valid) throw_exception("Cannot retrieve value before running the parser");
+            return has_value();
+        }
+
+        /**
+         * \brief Set the delimiter that is used to split arguments when using = to assign values.
+         * \param c Delimiter.
+         */
+        void set_delimiter(const char c) noexcept { delimiter = c; }
+
+        void reset() override
+        {
+            base_list::reset();
+            truncate();
+            hasher = {};
+        }
+
+    protected:
+        [[nodiscard]] argument_state_ptr save() const override
+        {
+            std::vector<value_type> values;
+            values.reserve(appended());
+            std::copy(std::next(target->begin(), initial_size), target->end(), std::back_inserter(values));
+            return std::make_shared<bound_list_state<C>>(std::move(values), hasher);
+        }
+
+        void restore(const argument_state& state) override
+        {
+            const auto& s = static_cast<const bound_list_state<C>&>(state);
+            truncate();
+            for (const auto& v : s.values) target->push_back(v);
+            hasher = s.hasher;
+        }
+
+        [[nodiscard]] bool has_value() const noexcept override { return appended() > 0; }
+
+        [[nodiscard]] fingerprint get_fingerprint() const noexcept override { return hasher.digest(); }
+
+        void parse(const std::string& arg, std::vector<parse_error_t>& parse_errors) noexcept override
+        {
+            detail::split(arg, delimiter, [&](const std::string& str) {
+                return check_append(append(str), arg, str, parse_errors);
+            });
+        }
+
+    private:
+        [[nodiscard]] size_t appended() const noexcept { return static_cast<size_t>(target->size()) - initial_size; }
+
+        void truncate() { target->erase(std::next(target->begin(), initial_size), target->end()); }
+
+        /**
+         * \brief Append a single value or, for integral lists, a range.
+         * \param str String.
+         * \return Whether the element was stored, or the reason the conversion failed.
+         */
+        std::expected<detail::append_status, conversion_error> append(const std::string& str)
+        {
+            if constexpr (range_parsable<value_type>)
+            {
+                if (detail::is_range(str))
+                {
+                    value_type first = 0, step = 1;
+                    uintmax_t  n = 0;
+                    if (!detail::parse_range(str, first, step, n))
+                        return std::unexpected(conversion_error::invalid_range);
+                    if (n >= max_range_elements) return detail::append_status::range_too_large;
+                    if (n >= max_elements - appended()) return detail::append_status::list_full;
+
+                    // Remove the partially expanded range if memory runs out.
+                    using U         = std::make_unsigned_t<value_type>;
+                    const auto size = static_cast<size_t>(target->size());
+                    const auto expand = [&] {
+                        for (uintmax_t i = 0; i <= n; i++)
+                            target->push_back(static_cast<value_type>(static_cast<U>(first) +
+                                                                      static_cast<U>(i) * static_cast<U>(step)));
+                    };
+                    if (!detail::try_allocate(expand))
+                    {
+                        target->erase(std::next(target->begin(), size), target->end());
+                        return detail::append_status::out_of_memory;
+                    }
+                    hasher.push(first, step, static_cast<size_t>(n) + 1);
+                    return detail::append_status::appended;
+                }
+            }
+
+            if (appended() == max_elements) return detail::append_status::list_full;
+
+            auto value = detail::parse_value<value_type>(str, pool);
+            if (!value) return std::unexpected(value.error());
+
+            // Only hash the value once it is stored.
+            auto h = hasher;
+            if constexpr (range_parsable<value_type>)
+                h.push(*value);
+            else
+            {
+                const auto d = detail::hash_value(*value, str);
+                h.add(d.low);
+                h.add(d.high);
+            }
+            if (!detail::try_allocate([&] { target->push_back(std::move(*value)); }))
+                return detail::append_status::out_of_memory;
+            hasher = std::move(h);
+            return detail::append_status::appended;
+        }
+
+        C*     target;
+        size_t initial_size;
+
+        /**
+         * \brief Running hash of the appended values, for the fingerprint of the parser.
+         */
+        typename bound_list_state<C>::hasher_t hasher;
+
+        char delimiter = ',';
+    };
+}  // namespace pt
@@ -0,0 +1,144 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/argument.h"
+#include "parsertongue/parse_error.h"
+#include "parsertongue/value.h"
+
+namespace pt
+{
+    class parser;
+
+    /**
+     * \brief Text encoding of binary data.
+     */
+    enum class binary_encoding : uint32_t
+    {
+        /**
+         * \brief Two hexadecimal digits per byte, upper or lower case.
+         */
+        hex,
+
+        /**
+         * \brief Standard base64 alphabet. Padding is optional.
+         */
+        base64
+    };
+
+    /**
+     * \brief Get the number of bytes that text decodes to. Only meaningful if the text is valid.
+     * \param encoding Encoding.
+     * \param text Encoded text.
+     * \return Number of bytes.
+     */
+    [[nodiscard]] size_t decoded_size(binary_encoding encoding, std::string_view text) noexcept;
+
+    /**
+     * \brief Decode text into a buffer. Uses SSE2 where available.
+     * \param encoding Encoding.
+     * \param text Encoded text.
+     * \param out Buffer of at least decoded_size bytes.
+     * \return Offset of the first invalid character in text, or std::string_view::npos if the text is valid.
+     */
+    [[nodiscard]] size_t decode(binary_encoding encoding, std::string_view text, uint8_t* out) noexcept;
+
+    /**
+     * \brief Decode text into a new vector.
+     * \param encoding Encoding.
+     * \param text Encoded text.
+     * \return Bytes, or the offset of the first invalid character in text.
+     */
+    [[nodiscard]] std::expected<std::vector<uint8_t>, size_t> decode(binary_encoding encoding, std::string_view text);
+
+    namespace detail
+    {
+        size_t decode_hex_scalar(std::string_view text, uint8_t* out) noexcept;
+
+        size_t decode_base64_scalar(std::string_view text, uint8_t* out) noexcept;
+    }  // namespace detail
+
+    class bytes_state final : public argument_state
+    {
+    public:
+        bytes_state(std::shared_ptr<const uint8_t[]> data, const size_t size, const fingerprint digest) :
+            data(std::move(data)), size(size), digest(digest)
+        {
+        }
+
+        const std::shared_ptr<const uint8_t[]> data;
+        const size_t                           size;
+        const fingerprint                      digest;
+    };
+
+    /**
+     * \brief Value that holds binary data, passed as hex or base64 text. The text is decoded while parsing, directly
+     * into a buffer of the decoded size. Snapshots share the buffer instead of copying it.
+     */
+    class bytes_value final : public base_value
+    {
+    public:
+        bytes_value() = delete;
+
+        bytes_value(const bytes_value&) = delete;
+
+        bytes_value(bytes_value&&) = delete;
+
+        bytes_value(char short_name, std::string long_name, binary_encoding encoding);
+
+        ~bytes_value() noexcept override = default;
+
+        bytes_value& operator=(const bytes_value&) = delete;
+
+        bytes_value& operator=(bytes_value&&) = delete;
+
+        /**
+         * \brief Check if the value was set. Throws an exception if the parser was not run yet.
+         * \return True if the value was set, false otherwise.
+         */
+        [[nodiscard]] bool is_set() const;
+
+        /**
+         * \brief Get the decoded bytes. Throws an exception if the parser was not run yet or the value was not set.
+         * \return Bytes.
+         */
+        [[nodiscard]] std::span<const uint8_t> get_value() const;
+
+        [[nodiscard]] binary_encoding get_encoding() const noexcept;
+
+        void reset() override;
+
+    protected:
+        [[nodiscard]] argument_state_ptr save() const override;
+
+        void restore(const argument_state& state) override;
+
+        [[nodiscard]] bool has_value() const noexcept override;
+
+        [[nodiscard]] fingerprint get_fingerprint() const noexcept override;
+
+        void parse(const std::string& arg, std::vector<parse_error_t>& parse_errors) noexcept override;
+
+    private:
+        binary_encoding                  encoding;
+        std::shared_ptr<const uint8_t[]> data;
+        size_t                           size = 0;
+        fingerprint                      digest;
+    };
+
+    using bytes_ptr = std::shared_ptr<bytes_value>;
+}  // namespace pt
@@ -0,0 +1,674 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/flag.h"
+#include "parsertongue/flat_map.h"
+#include "parsertongue/list.h"
+#include "parsertongue/parser_tongue_exception.h"
+#include "parsertongue/value.h"
+
+////////////////////////////////////////////////////////////////
+// Arrow C data interface. Defined exactly as in the Arrow
+// specification, so that it can be combined with the Arrow
+// headers.
+////////////////////////////////////////////////////////////////
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema
+{
+    const char*          format;
+    const char*          name;
+    const char*          metadata;
+    int64_t              flags;
+    int64_t              n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema*  dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray
+{
+    int64_t             length;
+    int64_t             null_count;
+    int64_t             offset;
+    int64_t             n_buffers;
+    int64_t             n_children;
+    const void**        buffers;
+    struct ArrowArray** children;
+    struct ArrowArray*  dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+#endif
+
+namespace pt
+{
+    class parser;
+
+    /**
+     * \brief Types that can be stored in a column: arithmetic types of up to 64 bits, and types that convert to
+     * std::string_view.
+     */
+    template<typename T>
+    concept columnar =
+      (std::is_arithmetic_v<T> && sizeof(T) <= 8) || std::convertible_to<const T&, std::string_view>;
+
+    namespace detail
+    {
+        /**
+         * \brief Array of the Arrow C data interface under construction. Owns the buffers it points to.
+         */
+        struct arrow_node
+        {
+            std::string                              format;
+            std::string                              name;
+            int64_t                                  flags      = 0;
+            int64_t                                  length     = 0;
+            int64_t                                  null_count = 0;
+            std::vector<const void*>                 buffers;
+            std::vector<std::shared_ptr<void>>       owners;
+            std::vector<std::unique_ptr<arrow_node>> children;
+            std::unique_ptr<arrow_node>              dictionary;
+
+            /**
+             * \brief Take ownership of a buffer and append it.
+             * \param buffer Vector of trivially copyable elements.
+             */
+            template<typename V>
+            void add_buffer(V&& buffer)
+            {
+                auto owned = std::make_shared<std::decay_t<V>>(std::forward<V>(buffer));
+                buffers.push_back(owned->empty() ? empty_buffer() : owned->data());
+                owners.emplace_back(std::move(owned));
+            }
+
+            /**
+             * \brief Get a zeroed, aligned buffer that is used for empty buffers, which must not be null.
+             */
+            static const void* empty_buffer() noexcept;
+        };
+
+        /**
+         * \brief Move an array into the Arrow C data interface.
+         * \param node Array.
+         * \param schema Schema to initialize.
+         * \param array Array to initialize.
+         */
+        void export_arrow(std::unique_ptr<arrow_node> node, ArrowSchema* schema, ArrowArray* array);
+
+        /**
+         * \brief Bitmap in the bit order of Arrow: bit i is bit i % 8 of byte i / 8.
+         */
+        class bitmap
+        {
+        public:
+            [[nodiscard]] size_t size() const noexcept { return bits; }
+
+            [[nodiscard]] bool operator[](const size_t i) const noexcept { return (bytes[i / 8] >> (i % 8)) & 1; }
+
+            [[nodiscard]] std::span<const uint8_t> get_bytes() const noexcept { return bytes; }
+
+            void push_back(const bool bit)
+            {
+                if (bits % 8 == 0) bytes.push_back(0);
+                if (bit) bytes.back() |= static_cast<uint8_t>(1u << (bits % 8));
+                bits++;
+            }
+
+            void reserve(const size_t n) { bytes.reserve((n + 7) / 8); }
+
+            /**
+             * \brief Move the bytes out, leaving the bitmap empty.
+             * \return Bytes.
+             */
+            [[nodiscard]] std::vector<uint8_t> release() noexcept
+            {
+                auto out = std::move(bytes);
+                bytes    = {};
+                bits     = 0;
+                return out;
+            }
+
+        private:
+            std::vector<uint8_t> bytes;
+            size_t               bits = 0;
+        };
+
+        /**
+         * \brief Contiguous storage for fixed-width values.
+         */
+        template<typename T>
+        class primitive_buffer
+        {
+        public:
+            [[nodiscard]] size_t size() const noexcept { return values.size(); }
+
+            [[nodiscard]] T operator[](const size_t i) const noexcept { return values[i]; }
+
+            [[nodiscard]] std::span<const T> get_values() const noexcept { return values; }
+
+            void push_back(const T value) { values.push_back(value); }
+
+            void push_null() { values.push_back(T{}); }
+
+            void reserve(const size_t n) { values.reserve(n); }
+
+            /**
+             * \brief Move the values into a node.
+             */
+            void release(arrow_node& node)
+            {
+                if constexpr (std::is_floating_point_v<T>)
+                    node.format = sizeof(T) == 4 ? "f" : "g";
+                else if constexpr (std::is_signed_v<T>)
+                    node.format = sizeof(T) == 1 ? "c" : sizeof(T) == 2 ? "s" : sizeof(T) == 4 ? "i" : "l";
+                else
+                    node.format = sizeof(T) == 1 ? "C" : sizeof(T) == 2 ? "S" : sizeof(T) == 4 ? "I" : "L";
+                node.add_buffer(std::move(values));
+                values = {};
+            }
+
+        private:
+            std::vector<T> values;
+        };
+
+        /**
+         * \brief Storage for booleans, packed into a bitmap.
+         */
+        class boolean_buffer
+        {
+        public:
+            [[nodiscard]] size_t size() const noexcept { return values.size(); }
+
+            [[nodiscard]] bool operator[](const size_t i) const noexcept { return values[i]; }
+
+            [[nodiscard]] std::span<const uint8_t> get_bytes() const noexcept { return values.get_bytes(); }
+
+            void push_back(const bool value) { values.push_back(value); }
+
+            void push_null() { values.push_back(false); }
+
+            void reserve(const size_t n) { values.reserve(n); }
+
+            void release(arrow_node& node)
+            {
+                node.format = "b";
+                node.add_buffer(values.release());
+            }
+
+        private:
+            bitmap values;
+        };
+
+        /**
+         * \brief Storage for strings: all characters in a single buffer, delimited by offsets.
+         */
+        class string_buffer
+        {
+        public:
+            [[nodiscard]] size_t size() const noexcept { return offsets.size() - 1; }
+
+            [[nodiscard]] std::string_view operator[](const size_t i) const noexcept
+            {
+                return {data.data() + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i])};
+            }
+
+            /**
+             * \brief Get the offsets. String i spans [offsets[i], offsets[i + 1]) of the data.
+             */
+            [[nodiscard]] std::span<const int64_t> get_offsets() const noexcept { return offsets; }
+
+            [[nodiscard]] std::span<const char> get_data() const noexcept { return data; }
+
+            void push_back(const std::string_view value)
+            {
+                data.insert(data.end(), value.begin(), value.end());
+                offsets.push_back(static_cast<int64_t>(data.size()));
+            }
+
+            void push_null() { offsets.push_back(offsets.back()); }
+
+            void reserve(const size_t n) { offsets.reserve(n + 1); }
+
+            void release(arrow_node& node)
+            {
+                node.format = "U";
+                node.add_buffer(std::move(offsets));
+                node.add_buffer(std::move(data));
+                offsets = {0};
+                data    = {};
+            }
+
+        private:
+            std::vector<int64_t> offsets = {0};
+            std::vector<char>    data;
+        };
+
+        template<columnar T>
+        using column_buffer = std::conditional_t<
+          std::same_as<T, bool>,
+          boolean_buffer,
+          std::conditional_t<std::is_arithmetic_v<T>, primitive_buffer<T>, string_buffer>>;
+    }  // namespace detail
+
+    /**
+     * \brief Column of a column_batch: one row per parse, with a validity bitmap that records whether the argument
+     * was set.
+     */
+    class column
+    {
+    public:
+        friend class column_batch;
+
+        column() = delete;
+
+        column(const column&) = delete;
+
+        column(column&&) = delete;
+
+        virtual ~column() noexcept = default;
+
+        column& operator=(const column&) = delete;
+
+        column& operator=(column&&) = delete;
+
+        [[nodiscard]] const std::string& get_name() const noexcept { return name; }
+
+        /**
+         * \brief Get the number of rows.
+         * \return Number of rows.
+         */
+        [[nodiscard]] size_t size() const noexcept { return validity.size(); }
+
+        /**
+         * \brief Get the number of rows in which the argument was not set.
+         * \return Number of rows.
+         */
+        [[nodiscard]] size_t get_null_count() const noexcept { return null_count; }
+
+        /**
+         * \brief Check if the argument was set in a row.
+         * \param row Row.
+         * \return True if the argument was set.
+         */
+        [[nodiscard]] bool is_valid(const size_t row) const noexcept { return validity[row]; }
+
+        /**
+         * \brief Get the validity bitmap. Bit i % 8 of byte i / 8 is set if the argument was set in row i.
+         * \return Bytes.
+         */
+        [[nodiscard]] std::span<const uint8_t> get_validity() const noexcept { return validity.get_bytes(); }
+
+    protected:
+        column(argument_ptr arg, std::string name) : arg(std::move(arg)), name(std::move(name)) {}
+
+        /**
+         * \brief Append a row with the current state of the argument.
+         */
+        virtual void append() = 0;
+
+        virtual void reserve(size_t rows) = 0;
+
+        /**
+         * \brief Move all rows into a node, leaving the column empty.
+         * \return Node.
+         */
+        [[nodiscard]] virtual std::unique_ptr<detail::arrow_node> release() = 0;
+
+        /**
+         * \brief Create a node for the validity bitmap and move the bitmap into it.
+         * \return Node.
+         */
+        [[nodiscard]] std::unique_ptr<detail::arrow_node> release_validity();
+
+        void push_validity(const bool valid)
+        {
+            validity.push_back(valid);
+            if (!valid) null_count++;
+        }
+
+        argument_ptr    arg;
+        std::string     name;
+        detail::bitmap  validity;
+        size_t          null_count = 0;
+    };
+
+    /**
+     * \brief Column of a flag. Flags are always valid.
+     */
+    class flag_column final : public column
+    {
+    public:
+        explicit flag_column(flag_ptr f, std::string name) : column(f, std::move(name)), f(std::move(f)) {}
+
+        [[nodiscard]] bool operator[](const size_t row) const noexcept { return values[row]; }
+
+        /**
+         * \brief Get the values, packed into a bitmap.
+         * \return Bytes.
+         */
+        [[nodiscard]] std::span<const uint8_t> get_values() const noexcept { return values.get_bytes(); }
+
+    protected:
+        void append() override
+        {
+            push_validity(true);
+            values.push_back(f->is_set());
+        }
+
+        void reserve(const size_t rows) override
+        {
+            validity.reserve(rows);
+            values.reserve(rows);
+        }
+
+        [[nodiscard]] std::unique_ptr<detail::arrow_node> release() override
+        {
+            auto node = release_validity();
+            values.release(*node);
+            return node;
+        }
+
+    private:
+        flag_ptr               f;
+        detail::boolean_buffer values;
+    };
+
+    /**
+     * \brief Column of a value. Rows in which the value was not set hold a zero or empty value.
+     * \tparam T Value type.
+     */
+    template<columnar T>
+    class value_column final : public column
+    {
+    public:
+        value_column(std::shared_ptr<value<T>> v, std::string name) : column(v, std::move(name)), v(std::move(v)) {}
+
+        /**
+         * \brief Get the value of a row.
+         * \param row Row.
+         * \return Value, or a std::string_view for string-like types.
+         */
+        [[nodiscard]] auto operator[](const size_t row) const noexcept { return values[row]; }
+
+        /**
+         * \brief Get the storage of the values: a primitive_buffer, boolean_buffer or string_buffer.
+         * \return Storage.
+         */
+        [[nodiscard]] const detail::column_buffer<T>& get_buffer() const noexcept { return values; }
+
+    protected:
+        void append() override
+        {
+            const auto set = v->is_set();
+            push_validity(set);
+            if (set)
+                values.push_back(v->get_value());
+            else
+                values.push_null();
+        }
+
+        void reserve(const size_t rows) override
+        {
+            validity.reserve(rows);
+            values.reserve(rows);
+        }
+
+        [[nodiscard]] std::unique_ptr<detail::arrow_node> release() override
+        {
+            auto node = release_validity();
+            values.release(*node);
+            return node;
+        }
+
+    private:
+        std::shared_ptr<value<T>> v;
+        detail::column_buffer<T>  values;
+    };
+
+    /**
+     * \brief Column of a list. The values of all rows are stored contiguously, delimited by offsets. Rows in which
+     * the list was not set are empty.
+     * \tparam T Value type.
+     * \tparam S Storage policy of the list.
+     */
+    template<columnar T, list_storage S = vector_storage>
+    class list_column final : public column
+    {
+    public:
+        list_column(std::shared_ptr<list<T, S>> l, std::string name) : column(l, std::move(name)), l(std::move(l))
+        {
+        }
+
+        /**
+         * \brief Get the offsets. Row i spans elements [offsets[i], offsets[i + 1]).
+         * \return Offsets.
+         */
+        [[nodiscard]] std::span<const int64_t> get_offsets() const noexcept { return offsets; }
+
+        /**
+         * \brief Get the storage of the elements of all rows.
+         * \return Storage.
+         */
+        [[nodiscard]] const detail::column_buffer<T>& get_buffer() const noexcept { return elements; }
+
+    protected:
+        void append() override
+        {
+            const auto set = l->is_set();
+            push_validity(set);
+            if (set)
+            {
+                // Write integral ranges without materialising them in the list.
+                if constexpr (detail::lazy_list<T, S>)
+                    for (const auto e : l->get_view()) elements.push_back(e);
+                else
+                    for (const auto& e : l->get_values()) elements.push_back(e);
+            }
+            offsets.push_back(static_cast<int64_t>(elements.size()));
+        }
+
+        void reserve(const size_t rows) override
+        {
+            validity.reserve(rows);
+            offsets.reserve(rows + 1);
+        }
+
+        [[nodiscard]] std::unique_ptr<detail::arrow_node> release() override
+        {
+            auto node    = release_validity();
+            node->format = "+L";
+            node->add_buffer(std::move(offsets));
+            offsets = {0};
+
+            auto child    = std::make_unique<detail::arrow_node>();
+            child->name   = "item";
+            child->length = static_cast<int64_t>(elements.size());
+            child->buffers.push_back(nullptr);
+            elements.release(*child);
+            node->children.emplace_back(std::move(child));
+            return node;
+        }
+
+    private:
+        std::shared_ptr<list<T, S>> l;
+        std::vector<int64_t>        offsets = {0};
+        detail::column_buffer<T>    elements;
+    };
+
+    /**
+     * \brief Column of the operands of each parse. Operands are dictionary encoded: each distinct operand is stored
+     * once, and rows hold indices into the dictionary.
+     */
+    class operand_column
+    {
+    public:
+        friend class column_batch;
+
+        [[nodiscard]] size_t size() const noexcept { return offsets.size() - 1; }
+
+        /**
+         * \brief Get the offsets. Row i spans indices [offsets[i], offsets[i + 1]).
+         * \return Offsets.
+         */
+        [[nodiscard]] std::span<const int64_t> get_offsets() const noexcept { return offsets; }
+
+        /**
+         * \brief Get the indices of the operands of all rows into the dictionary.
+         * \return Indices.
+         */
+        [[nodiscard]] std::span<const int32_t> get_indices() const noexcept { return indices; }
+
+        /**
+         * \brief Get the distinct operands.
+         * \return Storage.
+         */
+        [[nodiscard]] const detail::string_buffer& get_dictionary() const noexcept { return dictionary; }
+
+    private:
+        void append(const std::vector<std::string>& operands);
+
+        void reserve(size_t rows);
+
+        [[nodiscard]] std::unique_ptr<detail::arrow_node> release();
+
+        std::vector<int64_t>                   offsets = {0};
+        std::vector<int32_t>                   indices;
+        detail::string_buffer                  dictionary;
+        flat_map<std::string, int32_t>         lookup;
+    };
+
+    /**
+     * \brief Sink that stores the results of many parses in columnar form, one row per parse: a contiguous typed
+     * column per argument, with validity bitmaps and offset buffers laid out as in Apache Arrow. Set it on a parser
+     * with parser::set_batch. Not thread safe: use one batch per parser.
+     */
+    class column_batch
+    {
+    public:
+        friend class parser;
+
+        column_batch() = default;
+
+        column_batch(const column_batch&) = delete;
+
+        column_batch(column_batch&&) = delete;
+
+        ~column_batch() noexcept = default;
+
+        column_batch& operator=(const column_batch&) = delete;
+
+        column_batch& operator=(column_batch&&) = delete;
+
+        /**
+         * \brief Add a column for a flag. Columns can only be added while the batch is empty.
+         * \param f Flag.
+         * \param name Optional name. Defaults to the long name, or the short name if there is none.
+         * \return Column.
+         */
+        std::shared_ptr<const flag_column> add_column(const flag_ptr& f, std::string name = "");
+
+        /**
+         * \brief Add a column for a value. Columns can only be added while the batch is empty.
+         * \tparam T Value type.
+         * \param v Value.
+         * \param name Optional name. Defaults to the long name, or the short name if there is none.
+         * \return Column.
+         */
+        template<columnar T>
+        std::shared_ptr<const value_column<T>> add_column(const std::shared_ptr<value<T>>& v, std::string name = "")
+        {
+            check_column(v);
+            auto c = std::make_shared<value_column<T>>(v, column_name(*v, std::move(name)));
+            columns.emplace_back(c);
+            return c;
+        }
+
+        /**
+         * \brief Add a column for a list. Columns can only be added while the batch is empty.
+         * \tparam T Value type.
+         * \tparam S Storage policy of the list.
+         * \param l List.
+         * \param name Optional name. Defaults to the long name, or the short name if there is none.
+         * \return Column.
+         */
+        template<columnar T, list_storage S>
+        std::shared_ptr<const list_column<T, S>> add_column(const std::shared_ptr<list<T, S>>& l,
+                                                            std::string                        name = "")
+        {
+            check_column(l);
+            auto c = std::make_shared<list_column<T, S>>(l, column_name(*l, std::move(name)));
+            columns.emplace_back(c);
+            return c;
+        }
+
+        /**
+         * \brief Get the number of rows.
+         * \return Number of rows.
+         */
+        [[nodiscard]] size_t size() const noexcept { return operands.size(); }
+
+        [[nodiscard]] const operand_column& get_operands() const noexcept { return operands; }
+
+        /**
+         * \brief Reserve memory for a number of rows. Strings and list elements are not included.
+         * \param rows Number of rows.
+         */
+        void reserve(size_t rows);
+
+        /**
+         * \brief Move all rows into a struct array of the Arrow C data interface, with a child per column and a
+         * final "operands" child. The batch is empty afterwards, so it can be exported in chunks. Both structs must
+         * be released by the consumer.
+         * \param schema Schema to initialize.
+         * \param array Array to initialize.
+         */
+        void export_arrow(ArrowSchema* schema, ArrowArray* array);
+
+    private:
+        void check_column(const argument_ptr& arg) const;
+
+        /**
+         * \brief Check if all columns belong to arguments of a parser.
+         * \param arguments Arguments of the parser.
+         * \return True if all columns belong to the parser.
+         */
+        [[nodiscard]] bool belongs_to(const std::vector<argument_ptr>& arguments) const noexcept;
+
+        static std::string column_name(const argument& arg, std::string name);
+
+        /**
+         * \brief Append a row with the current state of all arguments.
+         * \param operand_list Operands.
+         */
+        void append(const std::vector<std::string>& operand_list);
+
+        std::vector<std::shared_ptr<column>> columns;
+        operand_column                       operands;
+    };
+}  // namespace pt
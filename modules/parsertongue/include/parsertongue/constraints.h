@@ -0,0 +1,117 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/argument.h"
+#include "parsertongue/parse_error.h"
+
+namespace pt
+{
+    /**
+     * \brief Set of constraints on which arguments the user must or must not pass together. Each constraint is
+     * compiled into a sparse bit mask over argument indices, so that all constraints are checked in a single pass that
+     * is linear in the number of arguments plus the total size of the constraints.
+     */
+    class constraints
+    {
+    public:
+        enum class type : uint32_t
+        {
+            /**
+             * \brief All arguments must be passed.
+             */
+            required,
+
+            /**
+             * \brief If the trigger is passed, all arguments must be passed.
+             */
+            dependency,
+
+            /**
+             * \brief At most one of the arguments may be passed.
+             */
+            conflict,
+
+            /**
+             * \brief Exactly one of the arguments must be passed.
+             */
+            exactly_one,
+
+            /**
+             * \brief At least one of the arguments must be passed.
+             */
+            at_least_one
+        };
+
+        constraints() = default;
+
+        constraints(const constraints&) = delete;
+
+        constraints(constraints&&) = default;
+
+        ~constraints() = default;
+
+        constraints& operator=(const constraints&) = delete;
+
+        constraints& operator=(constraints&&) = default;
+
+        /**
+         * \brief Add a constraint.
+         * \param constraint_type Type of constraint.
+         * \param trigger Trigger argument. Only used by dependency constraints.
+         * \param args Arguments the constraint applies to.
+         */
+        void add(type constraint_type, const argument* trigger, const std::vector<const argument*>& args);
+
+        [[nodiscard]] bool empty() const noexcept;
+
+        /**
+         * \brief Check all constraints and record an error for each violation.
+         * \param arguments All arguments of the parser, in order of registration.
+         * \param parse_errors List of errors.
+         */
+        void check(const std::vector<argument_ptr>& arguments, std::vector<parse_error_t>& parse_errors) const;
+
+    private:
+        struct mask_word
+        {
+            size_t   word = 0;
+            uint64_t bits = 0;
+        };
+
+        struct constraint
+        {
+            type                   constraint_type = type::required;
+            size_t                 trigger         = 0;
+            size_t                 size            = 0;
+            std::vector<mask_word> mask;
+        };
+
+        enum class selection
+        {
+            all,
+            passed,
+            missing
+        };
+
+        /**
+         * \brief Concatenate the names of the selected arguments in a mask.
+         */
+        [[nodiscard]] static std::string names(const std::vector<argument_ptr>& arguments,
+                                               const std::vector<uint64_t>&     passed,
+                                               const std::vector<mask_word>&    mask,
+                                               selection                        sel);
+
+        std::vector<constraint> list;
+    };
+}  // namespace pt
@@ -0,0 +1,32 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <concepts>
+#include <string_view>
+
+namespace pt
+{
+    /**
+     * \brief Customization point for converting strings to values. Specialise this for a type to parse it without a
+     * std::stringstream. A specialisation must provide
+     *
+     *     static bool parse(std::string_view arg, T& value) noexcept;
+     *
+     * that returns false if arg is not a valid value. The specialisation must be visible wherever the type is used
+     * as a value or list.
+     * \tparam T Type.
+     */
+    template<typename T>
+    struct converter;
+
+    template<typename T>
+    concept has_converter = requires(std::string_view arg, T& value)
+    {
+        {
+            converter<T>::parse(arg, value)
+            } -> std::same_as<bool>;
+    };
+}  // namespace pt
@@ -0,0 +1,168 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <compare>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/converter.h"
+#include "parsertongue/parser_tongue_exception.h"
+
+namespace pt
+{
+    /**
+     * \brief Number of bytes. Parsed from an integer or decimal number with an optional SI (kB, MB, ...) or IEC (KiB,
+     * MiB, ...) suffix.
+     */
+    struct byte_size
+    {
+        uint64_t bytes = 0;
+
+        auto operator<=>(const byte_size&) const = default;
+    };
+
+    /**
+     * \brief IPv4 or IPv6 address in network byte order. IPv4 addresses only use the first 4 bytes.
+     */
+    struct ip_address
+    {
+        enum class family : uint8_t
+        {
+            v4,
+            v6
+        };
+
+        family                  type  = family::v4;
+        std::array<uint8_t, 16> bytes = {};
+
+        auto operator<=>(const ip_address&) const = default;
+    };
+
+    /**
+     * \brief IP address with a port. Parsed from a.b.c.d:port or [IPv6]:port.
+     */
+    struct ip_endpoint
+    {
+        ip_address address;
+        uint16_t   port = 0;
+
+        auto operator<=>(const ip_endpoint&) const = default;
+    };
+
+    namespace detail
+    {
+        /**
+         * \brief Parse a duration of one or more components with units ns, us, ms, s, m, min, h or d, e.g. 1h30m or
+         * 1.5s, into nanoseconds.
+         * \param arg String.
+         * \param ns Nanoseconds.
+         * \return False if arg is not a valid duration or does not fit.
+         */
+        bool parse_duration(std::string_view arg, int64_t& ns) noexcept;
+
+        bool parse_byte_size(std::string_view arg, uint64_t& bytes) noexcept;
+
+        bool parse_ip_address(std::string_view arg, ip_address& address) noexcept;
+
+        bool parse_ip_endpoint(std::string_view arg, ip_endpoint& endpoint) noexcept;
+    }  // namespace detail
+
+    /**
+     * \brief Durations are parsed from one or more components with a unit, e.g. 250ms or 1h30m. A number without a
+     * unit is interpreted in the period of the duration. Values that cannot be represented exactly by an integral
+     * duration are rejected.
+     */
+    template<typename Rep, typename Period>
+    struct converter<std::chrono::duration<Rep, Period>>
+    {
+        static bool parse(const std::string_view arg, std::chrono::duration<Rep, Period>& value) noexcept
+        {
+            using target = std::chrono::duration<Rep, Period>;
+
+            if (arg.empty()) return false;
+
+            // Plain number in the period of the target.
+            if (const auto c = arg.back(); c >= '0' && c <= '9')
+            {
+                Rep                  count{};
+                const auto           begin = arg.data() + (arg.front() == '+' ? 1 : 0);
+                const auto [ptr, ec]       = std::from_chars(begin, arg.data() + arg.size(), count);
+                if (ec != std::errc() || ptr != arg.data() + arg.size()) return false;
+                value = target(count);
+                return true;
+            }
+
+            int64_t ns = 0;
+            if (!detail::parse_duration(arg, ns)) return false;
+
+            const auto d = std::chrono::nanoseconds(ns);
+            if constexpr (std::is_floating_point_v<Rep>)
+                value = std::chrono::duration_cast<target>(d);
+            else
+            {
+                const auto count = std::chrono::duration<long double, Period>(d).count();
+                if (count < static_cast<long double>(std::numeric_limits<Rep>::lowest()) ||
+                    count > static_cast<long double>(std::numeric_limits<Rep>::max()))
+                    return false;
+                const auto t = std::chrono::duration_cast<target>(d);
+                if (std::chrono::duration_cast<std::chrono::nanoseconds>(t) != d) return false;
+                value = t;
+            }
+            return true;
+        }
+    };
+
+    template<>
+    struct converter<byte_size>
+    {
+        static bool parse(const std::string_view arg, byte_size& value) noexcept
+        {
+            return detail::parse_byte_size(arg, value.bytes);
+        }
+    };
+
+    template<>
+    struct converter<ip_address>
+    {
+        static bool parse(const std::string_view arg, ip_address& value) noexcept
+        {
+            return detail::parse_ip_address(arg, value);
+        }
+    };
+
+    template<>
+    struct converter<ip_endpoint>
+    {
+        static bool parse(const std::string_view arg, ip_endpoint& value) noexcept
+        {
+            return detail::parse_ip_endpoint(arg, value);
+        }
+    };
+
+    /**
+     * \brief Paths are constructed directly from the argument. Empty paths are rejected, and so are paths for which
+     * no memory could be allocated.
+     */
+    template<>
+    struct converter<std::filesystem::path>
+    {
+        static bool parse(const std::string_view arg, std::filesystem::path& value) noexcept
+        {
+            if (arg.empty()) return false;
+            return detail::try_allocate([&] { value = std::filesystem::path(arg); });
+        }
+    };
+}  // namespace pt
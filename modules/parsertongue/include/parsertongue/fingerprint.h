@@ -0,0 +1,258 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace pt
+{
+    /**
+     * \brief 128-bit hash of the parsed values of a parser. Equal for command lines that produce the same values,
+     * regardless of the order of arguments, how they were spelled and how often they were repeated.
+     */
+    struct fingerprint
+    {
+        uint64_t low  = 0;
+        uint64_t high = 0;
+
+        auto operator<=>(const fingerprint&) const = default;
+
+        /**
+         * \brief Addition modulo 2^128. Used to combine the fingerprints of arguments independent of their order.
+         */
+        fingerprint& operator+=(const fingerprint& other) noexcept
+        {
+            const auto l = low + other.low;
+            high += other.high + (l < low ? 1 : 0);
+            low = l;
+            return *this;
+        }
+
+        fingerprint& operator-=(const fingerprint& other) noexcept
+        {
+            const auto l = low - other.low;
+            high -= other.high + (low < other.low ? 1 : 0);
+            low = l;
+            return *this;
+        }
+
+        /**
+         * \brief Format as 32 lowercase hexadecimal characters.
+         * \return String.
+         */
+        [[nodiscard]] std::string to_string() const
+        {
+            constexpr std::string_view digits = "0123456789abcdef";
+            std::string                s(32, '0');
+            for (size_t i = 0; i < 16; i++)
+            {
+                s[15 - i] = digits[(high >> (i * 4)) & 0xf];
+                s[31 - i] = digits[(low >> (i * 4)) & 0xf];
+            }
+            return s;
+        }
+    };
+
+    /**
+     * \brief Streaming 128-bit hash. Not cryptographic, but stable across platforms and processes.
+     */
+    class fingerprint_hasher
+    {
+    public:
+        void add(const uint64_t word) noexcept
+        {
+            a = std::rotl(a ^ (word * 0x87c37b91114253d5ull), 31) * 0x4cf5ad432745937full;
+            b = std::rotl(b ^ (word * 0x52dce729da3ed7b5ull), 33) * 0x9e3779b97f4a7c15ull + a;
+            length++;
+        }
+
+        void add(const std::string_view bytes) noexcept
+        {
+            size_t i = 0;
+            for (; i + 8 <= bytes.size(); i += 8) add(load(bytes.data() + i, 8));
+            if (i < bytes.size()) add(load(bytes.data() + i, bytes.size() - i));
+            add(static_cast<uint64_t>(bytes.size()));
+        }
+
+        [[nodiscard]] fingerprint digest() const noexcept
+        {
+            auto x = mix(a ^ length);
+            auto y = mix(b + x);
+            x      = mix(x + y);
+            return {.low = x, .high = y};
+        }
+
+    private:
+        static uint64_t load(const char* p, const size_t n) noexcept
+        {
+            // Little-endian, so that the hash does not depend on the platform.
+            uint64_t w = 0;
+            for (size_t i = 0; i < n; i++) w |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (i * 8);
+            return w;
+        }
+
+        static uint64_t mix(uint64_t x) noexcept
+        {
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdull;
+            x ^= x >> 33;
+            x *= 0xc4ceb9fe1a85ec53ull;
+            x ^= x >> 33;
+            return x;
+        }
+
+        uint64_t a      = 0x6a09e667f3bcc908ull;
+        uint64_t b      = 0xbb67ae8584caa73bull;
+        uint64_t length = 0;
+    };
+
+    /**
+     * \brief Types of which the converted value can be hashed. Other types are hashed by the string they were parsed
+     * from.
+     */
+    template<typename T>
+    concept fingerprintable = std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+                              std::convertible_to<const T&, std::string_view> ||
+                              std::has_unique_object_representations_v<T> || requires(const T& v)
+    {
+        typename T::period;
+        {
+            v.count()
+            } -> std::convertible_to<typename T::rep>;
+    };
+
+    namespace detail
+    {
+        template<fingerprintable T>
+        void hash_value(fingerprint_hasher& hasher, const T& value) noexcept
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                // Make 0.0 and -0.0 hash equal.
+                const auto d = value == T{0} ? 0.0 : static_cast<double>(value);
+                hasher.add(std::bit_cast<uint64_t>(d));
+            }
+            else if constexpr (std::is_integral_v<T>)
+                hasher.add(static_cast<uint64_t>(value));
+            else if constexpr (std::is_enum_v<T>)
+                hasher.add(static_cast<uint64_t>(static_cast<std::underlying_type_t<T>>(value)));
+            else if constexpr (std::convertible_to<const T&, std::string_view>)
+                hasher.add(static_cast<std::string_view>(value));
+            else if constexpr (std::has_unique_object_representations_v<T>)
+            {
+                char bytes[sizeof(T)];
+                std::memcpy(bytes, &value, sizeof(T));
+                hasher.add(std::string_view(bytes, sizeof(T)));
+            }
+            else
+                hash_value(hasher, value.count());
+        }
+
+        /**
+         * \brief Hash of a value, or of the string it was parsed from if its type is not fingerprintable.
+         */
+        template<typename T>
+        fingerprint hash_value(const T& value, const std::string& arg) noexcept
+        {
+            fingerprint_hasher hasher;
+            if constexpr (fingerprintable<T>)
+                hash_value(hasher, value);
+            else
+                hasher.add(std::string_view(arg));
+            return hasher.digest();
+        }
+
+        /**
+         * \brief Hash of a sequence of integers that is independent of how it was spelled: the sequence is split
+         * greedily into arithmetic progressions and those are hashed, so 1-3 and 1,2,3 hash equal. Appending a value
+         * or a whole range takes constant time.
+         * \tparam T Integral type.
+         */
+        template<typename T>
+        class sequence_hasher
+        {
+        public:
+            void push(const T value) noexcept
+            {
+                const auto v = static_cast<U>(value);
+                if (count == 0)
+                {
+                    first = v;
+                    count = 1;
+                }
+                else if (count == 1)
+                {
+                    step  = static_cast<U>(v - first);
+                    count = 2;
+                }
+                else if (v == at(first, step, count))
+                    count++;
+                else
+                {
+                    close();
+                    first = v;
+                    count = 1;
+                }
+            }
+
+            void push(const T range_first, const T range_step, const size_t range_count) noexcept
+            {
+                // After at most a few values, the range either continues the current progression or starts its own.
+                for (size_t i = 0; i < range_count; i++)
+                {
+                    const auto v = at(static_cast<U>(range_first), static_cast<U>(range_step), i);
+                    if (count >= 2 && step == static_cast<U>(range_step) && v == at(first, step, count))
+                    {
+                        count += range_count - i;
+                        return;
+                    }
+                    push(static_cast<T>(v));
+                }
+            }
+
+            [[nodiscard]] fingerprint digest() const noexcept
+            {
+                auto h = hasher;
+                if (count > 0)
+                {
+                    h.add(static_cast<uint64_t>(first));
+                    h.add(count > 1 ? static_cast<uint64_t>(step) : 0);
+                    h.add(static_cast<uint64_t>(count));
+                }
+                return h.digest();
+            }
+
+        private:
+            using U = std::make_unsigned_t<T>;
+
+            /**
+             * \brief Value n of a progression, wrapping like the unsigned type.
+             */
+            static U at(const U f, const U s, const size_t n) noexcept
+            {
+                return static_cast<U>(static_cast<uint64_t>(f) + static_cast<uint64_t>(s) * static_cast<uint64_t>(n));
+            }
+
+            void close() noexcept
+            {
+                hasher.add(static_cast<uint64_t>(first));
+                hasher.add(count > 1 ? static_cast<uint64_t>(step) : 0);
+                hasher.add(static_cast<uint64_t>(count));
+            }
+
+            fingerprint_hasher hasher;
+            U                  first = 0;
+            U                  step  = 0;
+            size_t             count = 0;
+        };
+    }  // namespace detail
+}  // namespace pt
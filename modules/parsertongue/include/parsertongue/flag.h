@@ -4,8 +4,10 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////
 // Current target includes.
@@ -17,6 +19,14 @@ namespace pt
 {
     class parser;
 
+    class flag_state final : public argument_state
+    {
+    public:
+        explicit flag_state(const bool value) : value(value) {}
+
+        const bool value;
+    };
+
     class flag final : public argument
     {
     public:
@@ -44,9 +54,49 @@ namespace pt
 
         void reset() override;
 
+    protected:
+        [[nodiscard]] argument_state_ptr save() const override;
+
+        void restore(const argument_state& state) override;
+
+        [[nodiscard]] bool has_value() const noexcept override;
+
+        [[nodiscard]] fingerprint get_fingerprint() const noexcept override;
+
+        void parse_env(const std::string& arg, std::vector<parse_error_t>& parse_errors) override;
+
     private:
+        /**
+         * \brief Set the flag and the storage it is bound to.
+         * \param v Value.
+         */
+        void set(bool v) noexcept;
+
+        /**
+         * \brief Write the flag to the storage it is bound to. A flag that was not passed restores the initial state
+         * of the storage.
+         */
+        void write() const noexcept;
+
         bool valid = false;
         bool value = false;
+
+        /**
+         * \brief Storage this flag is bound to with parser::bind_flag, or null.
+         */
+        void* target = nullptr;
+
+        /**
+         * \brief Bits of the storage that are set by this flag.
+         */
+        uint64_t mask = 0;
+
+        /**
+         * \brief State of the bound storage before parsing.
+         */
+        bool initial = false;
+
+        void (*store)(void* target, uint64_t mask, bool value) noexcept = nullptr;
     };
 
     using flag_ptr = std::shared_ptr<flag>;
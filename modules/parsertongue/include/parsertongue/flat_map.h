@@ -0,0 +1,215 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/parser_tongue_exception.h"
+
+namespace pt
+{
+    /**
+     * \brief Types that can be used to look up keys of type K in a flat_map: K itself and, if K is string-like,
+     * anything convertible to std::string_view.
+     */
+    template<typename Q, typename K>
+    concept flat_map_key = std::same_as<Q, K> || (std::convertible_to<const K&, std::string_view> &&
+                                                   std::convertible_to<const Q&, std::string_view>);
+
+    /**
+     * \brief Hash map that stores its elements contiguously in insertion order, indexed by an open addressing table
+     * with linear probing. Hashes are mixed before they select a slot, so that keys whose std::hash differs only in
+     * the high bits (std::hash is the identity for integers) do not share a probe chain. Elements are never removed
+     * individually. String-like keys can be looked up by
+     * std::string_view without constructing a key.
+     * \tparam K Key type.
+     * \tparam V Value type.
+     */
+    template<typename K, typename V>
+    class flat_map
+    {
+    public:
+        using value_type     = std::pair<K, V>;
+        using const_iterator = typename std::vector<value_type>::const_iterator;
+
+        [[nodiscard]] size_t size() const noexcept { return elements.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return elements.empty(); }
+
+        [[nodiscard]] const_iterator begin() const noexcept { return elements.begin(); }
+
+        [[nodiscard]] const_iterator end() const noexcept { return elements.end(); }
+
+        void clear() noexcept
+        {
+            elements.clear();
+            hashes.clear();
+            slots.clear();
+        }
+
+        void reserve(const size_t n)
+        {
+            elements.reserve(n);
+            hashes.reserve(n);
+            if (n * 2 > slots.size()) rehash(std::bit_ceil(n * 2));
+        }
+
+        /**
+         * \brief Find an element.
+         * \param key Key.
+         * \return Iterator to the element, or end.
+         */
+        template<flat_map_key<K> Q>
+        [[nodiscard]] const_iterator find(const Q& key) const noexcept
+        {
+            const auto i = lookup(key, hash(key));
+            return i == npos ? end() : begin() + static_cast<std::ptrdiff_t>(i);
+        }
+
+        template<flat_map_key<K> Q>
+        [[nodiscard]] bool contains(const Q& key) const noexcept
+        {
+            return lookup(key, hash(key)) != npos;
+        }
+
+        /**
+         * \brief Get the value of an element. Throws an exception if there is no element with the key.
+         * \param key Key.
+         * \return Value.
+         */
+        template<flat_map_key<K> Q>
+        [[nodiscard]] const V& at(const Q& key) const
+        {
+            const auto i = lookup(key, hash(key));
+            if (i == npos) throw_exception("Key not found");
+            return elements[i].second;
+        }
+
+        /**
+         * \brief Insert an element if there is none with the same key yet.
+         * \param key Key.
+         * \param value Value.
+         * \return Iterator to the element with the key, and whether the element was inserted.
+         */
+        std::pair<const_iterator, bool> try_emplace(K key, V value)
+        {
+            const auto h = hash(key);
+            if (const auto i = lookup(key, h); i != npos)
+                return {begin() + static_cast<std::ptrdiff_t>(i), false};
+
+            // Keep the load factor at most 1/2.
+            if ((elements.size() + 1) * 2 > slots.size()) rehash(slots.empty() ? 16 : slots.size() * 2);
+
+            // Grow both vectors before adding to either, so that they stay in step if an allocation fails.
+            if (elements.size() == elements.capacity()) elements.reserve(elements.size() * 2 + 1);
+            if (hashes.size() == hashes.capacity()) hashes.reserve(hashes.size() * 2 + 1);
+            elements.emplace_back(std::move(key), std::move(value));
+            hashes.push_back(h);
+            insert(elements.size() - 1);
+            return {end() - 1, true};
+        }
+
+        /**
+         * \brief Insert an element, or replace the value of the element with the same key.
+         * \param key Key.
+         * \param value Value.
+         * \return Iterator to the element with the key, and whether the element was inserted.
+         */
+        std::pair<const_iterator, bool> insert_or_assign(K key, V value)
+        {
+            const auto h = hash(key);
+            if (const auto i = lookup(key, h); i != npos)
+            {
+                elements[i].second = std::move(value);
+                return {begin() + static_cast<std::ptrdiff_t>(i), false};
+            }
+            return try_emplace(std::move(key), std::move(value));
+        }
+
+    private:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        template<typename Q>
+        static size_t hash(const Q& key) noexcept
+        {
+            if constexpr (std::convertible_to<const K&, std::string_view>)
+                return std::hash<std::string_view>{}(static_cast<std::string_view>(key));
+            else
+                return std::hash<K>{}(key);
+        }
+
+        /**
+         * \brief Get the first slot to probe for a hash: the high bits of the hash multiplied by 2^64 / phi (Fibonacci
+         * hashing), which depend on all bits of the hash.
+         */
+        [[nodiscard]] size_t home(const size_t h) const noexcept
+        {
+            const auto mixed = static_cast<uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(mixed >> (64 - std::countr_zero(slots.size())));
+        }
+
+        template<typename Q>
+        static bool equal(const K& key, const Q& other) noexcept
+        {
+            if constexpr (std::convertible_to<const K&, std::string_view>)
+                return static_cast<std::string_view>(key) == static_cast<std::string_view>(other);
+            else
+                return key == other;
+        }
+
+        template<typename Q>
+        [[nodiscard]] size_t lookup(const Q& key, const size_t h) const noexcept
+        {
+            if (slots.empty()) return npos;
+
+            const auto mask = slots.size() - 1;
+            for (auto s = home(h);; s = (s + 1) & mask)
+            {
+                const auto slot = slots[s];
+                if (slot == 0) return npos;
+                if (hashes[slot - 1] == h && equal(elements[slot - 1].first, key)) return slot - 1;
+            }
+        }
+
+        void insert(const size_t i) noexcept
+        {
+            const auto mask = slots.size() - 1;
+            auto       s    = home(hashes[i]);
+            while (slots[s] != 0) s = (s + 1) & mask;
+            slots[s] = static_cast<uint32_t>(i + 1);
+        }
+
+        void rehash(const size_t capacity)
+        {
+            slots.assign(capacity, 0);
+            for (size_t i = 0; i < elements.size(); i++) insert(i);
+        }
+
+        /**
+         * \brief Elements in insertion order.
+         */
+        std::vector<value_type> elements;
+
+        /**
+         * \brief Hash of the key of each element, so that growing the table does not hash keys again.
+         */
+        std::vector<size_t> hashes;
+
+        /**
+         * \brief Index + 1 of the element in each slot, or 0 if the slot is empty. The size is a power of 2.
+         */
+        std::vector<uint32_t> slots;
+    };
+}  // namespace pt
@@ -4,8 +4,17 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <expected>
 #include <format>
-#include <sstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 ////////////////////////////////////////////////////////////////
@@ -13,14 +22,117 @@
 ////////////////////////////////////////////////////////////////
 
 #include "parsertongue/argument.h"
+#include "parsertongue/list_storage.h"
+#include "parsertongue/list_view.h"
 #include "parsertongue/parsable.h"
 #include "parsertongue/parser_tongue_exception.h"
 #include "parsertongue/parse_error.h"
+#include "parsertongue/parse_limits.h"
+#include "parsertongue/string_pool.h"
+#include "parsertongue/validator.h"
 
 namespace pt
 {
     class parser;
 
+    namespace detail
+    {
+        /**
+         * \brief Split an argument into list elements on a delimiter. Like std::getline, a trailing delimiter does not
+         * produce an empty element.
+         * \param arg Argument.
+         * \param delimiter Delimiter.
+         * \param f Function that is invoked with each element. Returns false to stop splitting.
+         */
+        template<typename F>
+        void split(const std::string& arg, const char delimiter, F&& f)
+        {
+            for (size_t begin = 0; begin < arg.size();)
+            {
+                auto end = arg.find(delimiter, begin);
+                if (end == std::string::npos) end = arg.size();
+                if (!f(arg.substr(begin, end - begin))) return;
+                begin = end + 1;
+            }
+        }
+
+        /**
+         * \brief Check if a list element denotes a range: it contains a '-' that is not a leading sign, or a ':'.
+         */
+        inline bool is_range(const std::string& str) noexcept
+        {
+            return str.find('-', 1) != std::string::npos || str.find(':') != std::string::npos;
+        }
+
+        template<range_parsable T>
+        bool parse_integer(const char* begin, const char* end, T& value) noexcept
+        {
+            const auto [ptr, ec] = std::from_chars(begin, end, value);
+            return begin != end && ec == std::errc() && ptr == end;
+        }
+
+        /**
+         * \brief Parse an inclusive range of the form first-last[:step].
+         * \param str String.
+         * \param first First element.
+         * \param step Step. At least 1.
+         * \param n Number of elements minus one.
+         * \return False if str is not a valid range.
+         */
+        template<range_parsable T>
+        bool parse_range(const std::string& str, T& first, T& step, uintmax_t& n) noexcept
+        {
+            const auto dash  = str.find('-', 1);
+            const auto colon = dash == std::string::npos ? std::string::npos : str.find(':', dash);
+            const auto end   = colon == std::string::npos ? str.size() : colon;
+            T          last  = 0;
+            step             = 1;
+            if (dash == std::string::npos || !parse_integer(str.data(), str.data() + dash, first) ||
+                !parse_integer(str.data() + dash + 1, str.data() + end, last) ||
+                (colon != std::string::npos && !parse_integer(str.data() + colon + 1, str.data() + str.size(), step)) ||
+                step < 1 || last < first)
+                return false;
+
+            // This also makes sure the number of elements can be represented.
+            using U = std::make_unsigned_t<T>;
+            n       = static_cast<uintmax_t>((static_cast<U>(last) - static_cast<U>(first)) / static_cast<U>(step));
+            return true;
+        }
+
+        /**
+         * \brief Guards the expansion of the ranges of a lazy list into its values, which is done once by the first
+         * reader.
+         */
+        struct materialisation
+        {
+            std::atomic<bool> done = false;
+            std::mutex        mutex;
+        };
+
+        /**
+         * \brief Outcome of storing an element or a range of a list.
+         */
+        enum class append_status
+        {
+            appended,
+
+            /**
+             * \brief The list would hold more than max_list_elements elements.
+             */
+            list_full,
+
+            /**
+             * \brief The range would be expanded into more than max_range_elements elements.
+             */
+            range_too_large,
+
+            /**
+             * \brief Memory for the elements could not be allocated.
+             */
+            out_of_memory
+        };
+    }  // namespace detail
+
     class base_list : public argument
     {
     public:
@@ -45,16 +157,118 @@ namespace pt
     protected:
         bool valid = false;
 
+        /**
+         * \brief Maximum number of elements. Set by the parser from its limits.
+         */
+        size_t max_elements = std::numeric_limits<size_t>::max();
+
+        /**
+         * \brief Maximum number of elements a range is expanded into. Set by the parser from its limits.
+         */
+        size_t max_range_elements = parse_limits{}.max_range_elements;
+
+        /**
+         * \brief Pool for interned strings. Set by the parser.
+         */
+        string_pool* pool = nullptr;
+
         virtual void parse(const std::string& arg, std::vector<parse_error_t>& parse_errors) noexcept = 0;
+
+        void parse_env(const std::string& arg, std::vector<parse_error_t>& parse_errors) override
+        {
+            parse(arg, parse_errors);
+        }
+
+        /**
+         * \brief Record an error if an element could not be stored.
+         * \param result Outcome of storing the element, or the reason its conversion failed.
+         * \param arg Argument.
+         * \param str Element.
+         * \param parse_errors List of errors.
+         * \return True if the element was stored.
+         */
+        bool check_append(const std::expected<detail::append_status, conversion_error>& result,
+                          const std::string&                                           arg,
+                          const std::string&                                           str,
+                          std::vector<parse_error_t>&                                  parse_errors) const
+        {
+            if (!result)
+            {
+                parse_errors.emplace_back(parse_error::parsing_error, arg, get_conversion_message(result.error(), str));
+                return false;
+            }
+
+            std::string message;
+            switch (*result)
+            {
+            case detail::append_status::appended: return true;
+            case detail::append_status::list_full:
+                message = std::format("{0} cannot hold more than {1} elements", get_pretty_name(), max_elements);
+                break;
+            case detail::append_status::range_too_large:
+                message = std::format(
+                  "{0} cannot expand a range into more than {1} elements", get_pretty_name(), max_range_elements);
+                break;
+            case detail::append_status::out_of_memory:
+                message = std::format("{0} could not allocate memory for its elements", get_pretty_name());
+                break;
+            }
+            parse_errors.emplace_back(parse_error::too_many_list_elements, arg, std::move(message));
+            return false;
+        }
     };
 
     using list_ptr = std::shared_ptr<base_list>;
 
-    template<parsable T>
+    template<parsable T, list_storage S = vector_storage>
+    class list;
+
+    namespace detail
+    {
+        /**
+         * \brief Running hash of the values of a list: ranges for lazy integral lists, an order-independent sum for
+         * lists with set semantics, and a sequence otherwise.
+         */
+        template<typename T, typename S>
+        using list_hasher = std::conditional_t<lazy_list<T, S>,
+                                               sequence_hasher<T>,
+                                               std::conditional_t<S::unique, fingerprint, fingerprint_hasher>>;
+    }  // namespace detail
+
+    template<parsable T, list_storage S = vector_storage>
+    class list_state final : public argument_state
+    {
+    public:
+        friend class list<T, S>;
+
+        explicit list_state(const list<T, S>& l) :
+            values(detail::lazy_list<T, S> ? typename S::template storage<T>{} : l.values),
+            segments(l.segments),
+            literals(l.literals),
+            count(l.count),
+            hasher(l.hasher)
+        {
+        }
+
+    private:
+        const typename S::template storage<T>                                                           values;
+        const std::conditional_t<detail::lazy_list<T, S>, std::vector<list_segment<T>>, std::tuple<>> segments;
+        const std::conditional_t<detail::lazy_list<T, S>, std::vector<T>, std::tuple<>>               literals;
+        const size_t                                                                                  count;
+        const detail::list_hasher<T, S>                                                               hasher;
+    };
+
+    /**
+     * \brief List of values.
+     * \tparam T Value type.
+     * \tparam S Storage policy: vector_storage, inline_storage<N>, reserved_storage, set_storage or chunked_storage.
+     */
+    template<parsable T, list_storage S>
     class list final : public base_list
     {
     public:
         friend class parser;
+        friend class list_state<T, S>;
 
         list() = delete;
 
@@ -76,18 +290,65 @@ namespace pt
          */
         [[nodiscard]] bool is_set() const
         {
-            if (!valid) throw parser_tongue_exception("Cannot retrieve value before running the parser");
-            return !values.empty();
+            if (!valid) throw_exception("Cannot retrieve value before running the parser");
+            return has_value();
         }
 
         /**
          * \brief Get the list of values that was passed to this argument. Throws an exception if the parser was not run yet or no values were set.
-         * \return List of values.
+         * For integral lists this materialises all ranges on the first call, and for set_storage it merges the
+         * elements that arrived out of order. Both are safe to do from multiple threads. Throws an exception if the ranges hold more than parse_limits::max_range_elements elements.
+         * \return List of values, as a const std::vector<T>& for the vector, reserved and set policies, a
+         * std::span<const T> for inline_storage and a const std::deque<T>& for chunked_storage.
+         */
+        [[nodiscard]] typename S::template storage<T>::view_type get_values() const
+        {
+            if (!is_set()) throw_exception(std::format("{0} was not set", get_pretty_name()));
+            if constexpr (detail::lazy_list<T, S>)
+            {
+                if (!materialised.done.load(std::memory_order_acquire))
+                {
+                    if (!can_materialise())
+                        throw_exception(
+                          std::format("{0} holds more than {1} elements in ranges, use get_view to iterate them",
+                                      get_pretty_name(),
+                                      max_range_elements));
+
+                    std::scoped_lock lock(materialised.mutex);
+                    if (!materialised.done.load(std::memory_order_relaxed))
+                    {
+                        values.clear();
+                        values.reserve(count);
+                        for (const auto v : list_view<T>(segments, literals, count)) values.push_back(v);
+                        materialised.done.store(true, std::memory_order_release);
+                    }
+                }
+            }
+            else if constexpr (S::deferred)
+            {
+                if (!materialised.done.load(std::memory_order_acquire))
+                {
+                    std::scoped_lock lock(materialised.mutex);
+                    if (!materialised.done.load(std::memory_order_relaxed))
+                    {
+                        values.settle();
+                        materialised.done.store(true, std::memory_order_release);
+                    }
+                }
+            }
+            return values.view();
+        }
+
+        /**
+         * \brief Get a lazy view over the values that were passed to this argument. Ranges are not materialised. Throws an exception if the parser was not run yet or no values were set.
+         * This is the only way to read lists with ranges of any size.
+         * \return View over values.
          */
-        [[nodiscard]] const std::vector<T>& get_values() const
+        [[nodiscard]] list_view<T> get_view() const
+            requires detail::lazy_list<T, S>
         {
-            if (!is_set()) throw parser_tongue_exception(std::format("{0} was not set", get_pretty_name()));
-            return values;
+            if (!is_set()) throw_exception(std::format("{0} was not set", get_pretty_name()));
+            return list_view<T>(segments, literals, count);
         }
 
         /**
@@ -96,36 +357,306 @@ namespace pt
          */
         void set_delimiter(const char c) noexcept { delimiter = c; }
 
+        /**
+         * \brief Add a validator that is run on all values at once after parsing. Failures are reported as
+         * validation_failed errors for the individual elements, but the values remain set.
+         * \param v Validator.
+         */
+        void add_validator(validator<T> v) { validators.emplace_back(std::move(v)); }
+
         void reset() override
         {
             base_list::reset();
             values.clear();
+            hasher = {};
+            if constexpr (detail::lazy_list<T, S>)
+            {
+                segments.clear();
+                literals.clear();
+                count = 0;
+            }
+            if constexpr (detail::deferred_list<T, S>) materialised.done.store(false, std::memory_order_relaxed);
         }
 
     protected:
-        void parse(const std::string& arg, std::vector<parse_error_t>& parse_errors) noexcept override
+        [[nodiscard]] argument_state_ptr save() const override
+        {
+            return std::make_shared<list_state<T, S>>(*this);
+        }
+
+        void restore(const argument_state& state) override
+        {
+            const auto& s = static_cast<const list_state<T, S>&>(state);
+            values        = s.values;
+            segments      = s.segments;
+            literals      = s.literals;
+            count         = s.count;
+            hasher        = s.hasher;
+            if constexpr (detail::deferred_list<T, S>) materialised.done.store(false, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] bool has_value() const noexcept override
+        {
+            if constexpr (detail::lazy_list<T, S>)
+                return count > 0;
+            else
+                return !values.empty();
+        }
+
+        [[nodiscard]] fingerprint get_fingerprint() const noexcept override
         {
-            try
+            if constexpr (S::unique && !detail::lazy_list<T, S>)
+                return hasher;
+            else
+                return hasher.digest();
+        }
+
+        void validate(std::vector<parse_error_t>& parse_errors) const override
+        {
+            if (validators.empty() || !has_value()) return;
+
+            // Validators receive all values at once, so the ranges have to be materialised.
+            if constexpr (detail::lazy_list<T, S>)
             {
-                std::stringstream stream(arg);
-                std::string       str;
-                T                 value;
-                while (std::getline(stream, str, delimiter))
+                if (!can_materialise())
                 {
-                    parse_value(str, value);
-                    values.push_back(value);
+                    parse_errors.emplace_back(parse_error::too_many_list_elements,
+                                              std::string{},
+                                              std::format("{0} cannot validate more than {1} elements in ranges",
+                                                          get_pretty_name(),
+                                                          max_range_elements));
+                    return;
                 }
             }
-            catch (std::exception& e)
+
+            const auto&                     vals = get_values();
+            std::vector<validation_failure> failures;
+            if constexpr (std::ranges::contiguous_range<decltype(vals)>)
+            {
+                for (const auto& validator : validators) validator(std::span<const T>(vals), failures);
+            }
+            else if constexpr (std::is_same_v<T, bool>)
             {
-                parse_errors.emplace_back(parse_error::parsing_error, arg, e.what());
+                // std::vector<bool> is not contiguous.
+                const auto copy = std::make_unique<bool[]>(vals.size());
+                std::ranges::copy(vals, copy.get());
+                const auto span = std::span<const T>(copy.get(), vals.size());
+                for (const auto& validator : validators) validator(span, failures);
             }
+            else
+            {
+                // Chunked storage is not contiguous.
+                const std::vector<T> copy(vals.begin(), vals.end());
+                for (const auto& validator : validators) validator(std::span<const T>(copy), failures);
+            }
+            for (auto& f : failures)
+            {
+                std::string str;
+                if constexpr (std::is_convertible_v<const T&, std::string>)
+                    str = vals[f.index];
+                else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+                    str = std::string_view(vals[f.index]);
+                parse_errors.emplace_back(parse_error::validation_failed,
+                                          std::move(str),
+                                          std::format("{0} element {1}: {2}", get_pretty_name(), f.index, f.message));
+            }
+        }
+
+        void parse(const std::string& arg, std::vector<parse_error_t>& parse_errors) noexcept override
+        {
+            if constexpr (detail::deferred_list<T, S>) materialised.done.store(false, std::memory_order_relaxed);
+
+            if constexpr (S::precount)
+            {
+                // Reserve exactly for the first argument, and grow geometrically when more arguments follow.
+                const auto n    = static_cast<size_t>(std::ranges::count(arg, delimiter)) + 1;
+                const auto size = values.size();
+                const auto reserve = [&] { values.reserve(size + std::min(std::max(n, size), max_elements - size)); };
+                if (!detail::try_allocate(reserve))
+                {
+                    check_append(detail::append_status::out_of_memory, arg, arg, parse_errors);
+                    return;
+                }
+            }
+
+            detail::split(arg, delimiter, [&](const std::string& str) {
+                std::expected<detail::append_status, conversion_error> appended;
+                if constexpr (detail::lazy_list<T, S>)
+                    appended = append(str);
+                else if constexpr (range_parsable<T>)
+                    appended = detail::is_range(str) ? append_range(str) : append_value(str);
+                else
+                    appended = append_value(str);
+
+                return check_append(appended, arg, str, parse_errors);
+            });
         }
 
     private:
-        std::vector<T> values;
-        char           delimiter = ',';
-    };
+        /**
+         * \brief Check if the ranges are small enough to be expanded into values.
+         */
+        [[nodiscard]] bool can_materialise() const noexcept
+            requires detail::lazy_list<T, S>
+        {
+            return count - literals.size() <= max_range_elements;
+        }
+
+        /**
+         * \brief Append a single value to the storage.
+         * \param str String.
+         * \return Whether the value was stored, or the reason the conversion failed.
+         */
+        std::expected<detail::append_status, conversion_error> append_value(const std::string& str)
+            requires(!detail::lazy_list<T, S>)
+        {
+            if (values.size() >= max_elements) return detail::append_status::list_full;
 
+            auto value = detail::parse_value<T>(str, pool);
+            if (!value) return std::unexpected(value.error());
+
+            const auto h      = detail::hash_value(*value, str);
+            bool       stored = false;
+            if (!detail::try_allocate([&] { stored = values.push_back(std::move(*value)); }))
+                return detail::append_status::out_of_memory;
+            if (stored) add_hash(h);
+            return detail::append_status::appended;
+        }
+
+        /**
+         * \brief Expand a range of the form first-last[:step] into the storage.
+         * \param str String.
+         * \return Whether the range was stored, or the reason the conversion failed.
+         */
+        std::expected<detail::append_status, conversion_error> append_range(const std::string& str)
+            requires(range_parsable<T> && !detail::lazy_list<T, S>)
+        {
+            T         first = 0, step = 1;
+            uintmax_t n = 0;
+            if (!detail::parse_range(str, first, step, n)) return std::unexpected(conversion_error::invalid_range);
+
+            // With set semantics, elements that are already present do not count towards the maximum.
+            if (n >= max_range_elements) return detail::append_status::range_too_large;
+            if (!S::unique && n >= max_elements - values.size()) return detail::append_status::list_full;
+
+            using U     = std::make_unsigned_t<T>;
+            auto status = detail::append_status::appended;
+            const auto expand = [&] {
+                if constexpr (!S::unique) values.reserve(values.size() + static_cast<size_t>(n) + 1);
+                for (uintmax_t i = 0; i <= n; i++)
+                {
+                    if (values.size() >= max_elements)
+                    {
+                        status = detail::append_status::list_full;
+                        return;
+                    }
+
+                    const auto value =
+                      static_cast<T>(static_cast<U>(first) + static_cast<U>(i) * static_cast<U>(step));
+                    fingerprint_hasher h;
+                    detail::hash_value(h, value);
+                    if (values.push_back(value)) add_hash(h.digest());
+                }
+            };
+            if (!detail::try_allocate(expand)) return detail::append_status::out_of_memory;
+            return status;
+        }
+
+        /**
+         * \brief Add the hash of an element that was stored.
+         */
+        void add_hash(const fingerprint& h) noexcept
+            requires(!detail::lazy_list<T, S>)
+        {
+            if constexpr (S::unique)
+                hasher += h;
+            else
+            {
+                hasher.add(h.low);
+                hasher.add(h.high);
+            }
+        }
+
+        /**
+         * \brief Append a single value or a range of the form first-last[:step] to the segments.
+         * \param str String.
+         * \return Whether the element was stored, or the reason the conversion failed.
+         */
+        std::expected<detail::append_status, conversion_error> append(const std::string& str)
+            requires detail::lazy_list<T, S>
+        {
+            if (!detail::is_range(str))
+            {
+                if (count == max_elements) return detail::append_status::list_full;
+
+                const auto value = parse_value<T>(str);
+                if (!value) return std::unexpected(value.error());
+
+                // Extend the trailing literal run, or start a new one.
+                if (segments.empty() || !segments.back().is_literal())
+                    segments.push_back({.offset = count, .count = 0, .source = literals.size()});
+                segments.back().count++;
+                literals.push_back(*value);
+                hasher.push(*value);
+                count++;
+                return detail::append_status::appended;
+            }
+
+            T         first = 0, step = 1;
+            uintmax_t n = 0;
+            if (!detail::parse_range(str, first, step, n)) return std::unexpected(conversion_error::invalid_range);
+            if (n >= max_elements - count) return detail::append_status::list_full;
+
+            segments.push_back({.offset = count, .count = static_cast<size_t>(n) + 1, .first = first, .step = step});
+            hasher.push(first, step, static_cast<size_t>(n) + 1);
+            count += static_cast<size_t>(n) + 1;
+            return detail::append_status::appended;
+        }
+
+        /**
+         * \brief Parsed values. For integral lists with lazy ranges these are only materialised on request by
+         * get_values.
+         */
+        mutable typename S::template storage<T> values;
+
+        [[no_unique_address]] mutable
+          std::conditional_t<detail::deferred_list<T, S>, detail::materialisation, std::tuple<>> materialised;
+
+        /**
+         * \brief For integral lists, the ranges and literal runs that make up the list.
+         */
+        [[no_unique_address]] std::conditional_t<detail::lazy_list<T, S>, std::vector<list_segment<T>>, std::tuple<>>
+          segments;
+
+        /**
+         * \brief For integral lists, all values that were passed individually.
+         */
+        [[no_unique_address]] std::conditional_t<detail::lazy_list<T, S>, std::vector<T>, std::tuple<>> literals;
+
+        /**
+         * \brief Running hash of the values, for the fingerprint of the parser.
+         */
+        detail::list_hasher<T, S> hasher;
+
+        std::vector<validator<T>> validators;
+
+        size_t count     = 0;
+        char   delimiter = ',';
+    };
 
-}  // namespace pt
\ No newline at end of file
+    // Instantiated in the library for common types.
+    extern template class list_state<int>;
+    extern template class list<int>;
+    extern template class list_state<int64_t>;
+    extern template class list<int64_t>;
+    extern template class list_state<uint64_t>;
+    extern template class list<uint64_t>;
+    extern template class list_state<double>;
+    extern template class list<double>;
+    extern template class list_state<float>;
+    extern template class list<float>;
+    extern template class list_state<bool>;
+    extern template class list<bool>;
+    extern template class list_state<std::string>;
+    extern template class list<std::string>;
+}  // namespace pt
@@ -0,0 +1,462 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/list_view.h"
+
+namespace pt
+{
+    /**
+     * \brief Base of all storage policies of list. Policies override the flags that apply to them and define a
+     * storage class template with push_back, reserve, clear, size, empty, operator[], begin, end and view, and
+     * settle if they are deferred.
+     */
+    struct storage_policy
+    {
+        /**
+         * \brief If true, ranges of integral lists are stored as ranges and only materialised by get_values.
+         */
+        static constexpr bool lazy_ranges = false;
+
+        /**
+         * \brief If true, duplicates are dropped and the fingerprint does not depend on the order of elements.
+         */
+        static constexpr bool unique = false;
+
+        /**
+         * \brief If true, storage is reserved for the number of elements in an argument before it is split.
+         */
+        static constexpr bool precount = false;
+
+        /**
+         * \brief If true, the storage only orders its elements when settle is called, which get_values does on the
+         * first call. Until then, operator[], begin, end and view do not cover all elements.
+         */
+        static constexpr bool deferred = false;
+    };
+
+    template<typename S>
+    concept list_storage = std::derived_from<S, storage_policy>;
+
+    /**
+     * \brief Default policy: elements are stored in a std::vector that grows geometrically. Ranges of integral lists
+     * are not expanded until get_values is called.
+     */
+    struct vector_storage : storage_policy
+    {
+        static constexpr bool lazy_ranges = true;
+
+        template<typename T>
+        class storage
+        {
+        public:
+            using view_type = const std::vector<T>&;
+
+            [[nodiscard]] size_t size() const noexcept { return values.size(); }
+
+            [[nodiscard]] bool empty() const noexcept { return values.empty(); }
+
+            [[nodiscard]] decltype(auto) operator[](const size_t i) const noexcept { return values[i]; }
+
+            [[nodiscard]] auto begin() const noexcept { return values.begin(); }
+
+            [[nodiscard]] auto end() const noexcept { return values.end(); }
+
+            [[nodiscard]] view_type view() const noexcept { return values; }
+
+            bool push_back(T value)
+            {
+                values.push_back(std::move(value));
+                return true;
+            }
+
+            void reserve(const size_t n) { values.reserve(n); }
+
+            void clear() noexcept { values.clear(); }
+
+        private:
+            std::vector<T> values;
+        };
+    };
+
+    /**
+     * \brief Vector that stores up to N elements inline, and moves all elements to the heap when it grows beyond.
+     * \tparam T Element type.
+     * \tparam N Number of inline elements.
+     */
+    template<typename T, size_t N>
+    class small_vector
+    {
+    public:
+        small_vector() noexcept = default;
+
+        small_vector(const small_vector& other) : heap(other.heap), on_heap(other.on_heap)
+        {
+            if (!on_heap)
+            {
+                std::uninitialized_copy_n(other.inline_data(), other.count, inline_data());
+                count = other.count;
+            }
+        }
+
+        small_vector(small_vector&& other) noexcept : heap(std::move(other.heap)), on_heap(other.on_heap)
+        {
+            if (!on_heap)
+            {
+                std::uninitialized_move_n(other.inline_data(), other.count, inline_data());
+                count = other.count;
+            }
+            other.clear();
+        }
+
+        ~small_vector() noexcept { std::destroy_n(inline_data(), count); }
+
+        small_vector& operator=(const small_vector& other)
+        {
+            if (this != &other)
+            {
+                small_vector copy(other);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        small_vector& operator=(small_vector&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                heap    = std::move(other.heap);
+                on_heap = other.on_heap;
+                if (!on_heap)
+                {
+                    std::uninitialized_move_n(other.inline_data(), other.count, inline_data());
+                    count = other.count;
+                }
+                other.clear();
+            }
+            return *this;
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return on_heap ? heap.size() : count; }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] const T* data() const noexcept { return on_heap ? heap.data() : inline_data(); }
+
+        [[nodiscard]] const T& operator[](const size_t i) const noexcept { return data()[i]; }
+
+        [[nodiscard]] const T* begin() const noexcept { return data(); }
+
+        [[nodiscard]] const T* end() const noexcept { return data() + size(); }
+
+        void push_back(T value)
+        {
+            if (on_heap)
+                heap.push_back(std::move(value));
+            else if (count < N)
+            {
+                std::construct_at(inline_data() + count, std::move(value));
+                count++;
+            }
+            else
+            {
+                // Move all inline elements to the heap at once.
+                heap.reserve(N * 2);
+                heap.insert(heap.end(),
+                            std::make_move_iterator(inline_data()),
+                            std::make_move_iterator(inline_data() + count));
+                heap.push_back(std::move(value));
+                std::destroy_n(inline_data(), count);
+                count   = 0;
+                on_heap = true;
+            }
+        }
+
+        void reserve(const size_t n)
+        {
+            if (on_heap) heap.reserve(n);
+        }
+
+        /**
+         * \brief Remove all elements. Elements are stored inline again afterwards.
+         */
+        void clear() noexcept
+        {
+            std::destroy_n(inline_data(), count);
+            count = 0;
+            heap.clear();
+            on_heap = false;
+        }
+
+    private:
+        [[nodiscard]] T* inline_data() noexcept { return std::launder(reinterpret_cast<T*>(buffer)); }
+
+        [[nodiscard]] const T* inline_data() const noexcept
+        {
+            return std::launder(reinterpret_cast<const T*>(buffer));
+        }
+
+        alignas(T) std::byte buffer[sizeof(T) * N];
+        size_t         count = 0;
+        std::vector<T> heap;
+        bool           on_heap = false;
+    };
+
+    /**
+     * \brief Policy for lists that are usually small: up to N elements are stored inside the list without a heap
+     * allocation.
+     * \tparam N Number of inline elements.
+     */
+    template<size_t N>
+    struct inline_storage : storage_policy
+    {
+        static_assert(N > 0, "Inline storage must hold at least one element");
+
+        template<typename T>
+        class storage
+        {
+        public:
+            using view_type = std::span<const T>;
+
+            [[nodiscard]] size_t size() const noexcept { return values.size(); }
+
+            [[nodiscard]] bool empty() const noexcept { return values.empty(); }
+
+            [[nodiscard]] const T& operator[](const size_t i) const noexcept { return values[i]; }
+
+            [[nodiscard]] const T* begin() const noexcept { return values.begin(); }
+
+            [[nodiscard]] const T* end() const noexcept { return values.end(); }
+
+            [[nodiscard]] view_type view() const noexcept { return {values.data(), values.size()}; }
+
+            bool push_back(T value)
+            {
+                values.push_back(std::move(value));
+                return true;
+            }
+
+            void reserve(const size_t n) { values.reserve(n); }
+
+            void clear() noexcept { values.clear(); }
+
+        private:
+            small_vector<T, N> values;
+        };
+    };
+
+    /**
+     * \brief Policy for huge lists: the elements of each argument are counted before it is split, so the vector is
+     * allocated once with the right size instead of growing geometrically.
+     */
+    struct reserved_storage : vector_storage
+    {
+        static constexpr bool lazy_ranges = false;
+        static constexpr bool precount    = true;
+    };
+
+    /**
+     * \brief Policy with set semantics: elements are kept unique as they are added and sorted when the values are
+     * read. The fingerprint of the list does not depend on the order or repetition of elements.
+     */
+    struct set_storage : storage_policy
+    {
+        static constexpr bool unique   = true;
+        static constexpr bool deferred = true;
+
+        template<typename T>
+            requires std::totally_ordered<T>
+        class storage
+        {
+        public:
+            using view_type = const std::vector<T>&;
+
+            [[nodiscard]] size_t size() const noexcept { return count; }
+
+            [[nodiscard]] bool empty() const noexcept { return count == 0; }
+
+            [[nodiscard]] decltype(auto) operator[](const size_t i) const noexcept { return values[i]; }
+
+            [[nodiscard]] auto begin() const noexcept { return values.begin(); }
+
+            [[nodiscard]] auto end() const noexcept { return values.end(); }
+
+            [[nodiscard]] view_type view() const noexcept { return values; }
+
+            /**
+             * \brief Add an element if it is not present yet. Elements that arrive out of order are collected in
+             * sorted runs of decreasing size that are merged like the digits of a binary counter, so that adding n
+             * elements in any order takes O(n log^2 n) time instead of inserting each into the middle of one vector.
+             * \param value Value.
+             * \return False if the element was already present.
+             */
+            bool push_back(T value)
+            {
+                // Appending in ascending order, e.g. from a range, is the common case.
+                if (runs.empty() && (values.empty() || values.back() < value))
+                {
+                    values.push_back(std::move(value));
+                    count++;
+                    return true;
+                }
+
+                if (contains(values, value)) return false;
+                for (const auto& r : runs)
+                    if (contains(r, value)) return false;
+
+                std::vector<T> run;
+                run.push_back(std::move(value));
+                while (!runs.empty() && runs.back().size() <= run.size())
+                {
+                    run = merge(runs.back(), run);
+                    runs.pop_back();
+                }
+                runs.push_back(std::move(run));
+                count++;
+                return true;
+            }
+
+            /**
+             * \brief Merge all runs into the sorted values.
+             */
+            void settle()
+            {
+                if (runs.empty()) return;
+
+                // Merge the small runs first, so that every element is moved O(1) times on average.
+                auto run = std::move(runs.back());
+                runs.pop_back();
+                while (!runs.empty())
+                {
+                    run = merge(runs.back(), run);
+                    runs.pop_back();
+                }
+                values = merge(values, run);
+            }
+
+            void reserve(const size_t n) { values.reserve(n); }
+
+            void clear() noexcept
+            {
+                values.clear();
+                runs.clear();
+                count = 0;
+            }
+
+        private:
+            /**
+             * \brief Check if a sorted run contains a value. Values outside the bounds of the run, e.g. descending
+             * ones, are rejected without a search.
+             */
+            [[nodiscard]] static bool contains(const std::vector<T>& run, const T& value)
+            {
+                if (run.empty() || value < run.front() || run.back() < value) return false;
+                return std::ranges::binary_search(run, value);
+            }
+
+            /**
+             * \brief Merge two sorted runs without common elements. Storage is reserved first, so the inputs are
+             * left intact if that fails.
+             */
+            [[nodiscard]] static std::vector<T> merge(std::vector<T>& a, std::vector<T>& b)
+            {
+                std::vector<T> merged;
+                merged.reserve(a.size() + b.size());
+                std::merge(std::make_move_iterator(a.begin()),
+                           std::make_move_iterator(a.end()),
+                           std::make_move_iterator(b.begin()),
+                           std::make_move_iterator(b.end()),
+                           std::back_inserter(merged));
+                return merged;
+            }
+
+            /**
+             * \brief Sorted elements. Complete once settled.
+             */
+            std::vector<T> values;
+
+            /**
+             * \brief Sorted runs of elements that arrived out of order, from large to small. Disjoint from each other
+             * and from values.
+             */
+            std::vector<std::vector<T>> runs;
+
+            /**
+             * \brief Number of elements in values and all runs.
+             */
+            size_t count = 0;
+        };
+    };
+
+    /**
+     * \brief Policy that stores elements in a std::deque, which never moves elements when it grows.
+     */
+    struct chunked_storage : storage_policy
+    {
+        template<typename T>
+        class storage
+        {
+        public:
+            using view_type = const std::deque<T>&;
+
+            [[nodiscard]] size_t size() const noexcept { return values.size(); }
+
+            [[nodiscard]] bool empty() const noexcept { return values.empty(); }
+
+            [[nodiscard]] decltype(auto) operator[](const size_t i) const noexcept { return values[i]; }
+
+            [[nodiscard]] auto begin() const noexcept { return values.begin(); }
+
+            [[nodiscard]] auto end() const noexcept { return values.end(); }
+
+            [[nodiscard]] view_type view() const noexcept { return values; }
+
+            bool push_back(T value)
+            {
+                values.push_back(std::move(value));
+                return true;
+            }
+
+            void reserve(size_t) noexcept {}
+
+            void clear() noexcept { values.clear(); }
+
+        private:
+            std::deque<T> values;
+        };
+    };
+
+    namespace detail
+    {
+        /**
+         * \brief Check if a list stores the ranges of an integral list lazily.
+         */
+        template<typename T, typename S>
+        constexpr bool lazy_list = range_parsable<T> && S::lazy_ranges;
+
+        /**
+         * \brief Check if a list has to prepare its values on the first call to get_values, either by expanding lazy
+         * ranges or by settling deferred storage.
+         */
+        template<typename T, typename S>
+        constexpr bool deferred_list = lazy_list<T, S> || S::deferred;
+    }  // namespace detail
+}  // namespace pt
@@ -0,0 +1,152 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace pt
+{
+    /**
+     * \brief Integral types for which lists accept the range syntax first-last[:step]. Character types are excluded,
+     * because they are parsed as single characters.
+     */
+    template<typename T>
+    concept range_parsable = std::integral<T> && !std::same_as<T, bool> && !std::same_as<T, char> &&
+                             !std::same_as<T, signed char> && !std::same_as<T, unsigned char> &&
+                             !std::same_as<T, wchar_t> && !std::same_as<T, char8_t> && !std::same_as<T, char16_t> &&
+                             !std::same_as<T, char32_t>;
+
+    /**
+     * \brief Compact descriptor of a consecutive part of a list. Either an arithmetic sequence of count elements
+     * starting at first, or (if step is 0) a run of count literal values stored elsewhere.
+     */
+    template<typename T>
+    struct list_segment
+    {
+        /**
+         * \brief Index of the first element of this segment in the list.
+         */
+        size_t offset = 0;
+
+        /**
+         * \brief Number of elements in this segment.
+         */
+        size_t count = 0;
+
+        /**
+         * \brief Index of the first literal value. Only used when step is 0.
+         */
+        size_t source = 0;
+
+        T first = 0;
+
+        T step = 0;
+
+        [[nodiscard]] bool is_literal() const noexcept { return step == 0; }
+
+        [[nodiscard]] T at(const size_t i, const std::vector<T>& literals) const noexcept
+        {
+            if (is_literal()) return literals[source + i];
+
+            // Compute in the unsigned domain so that descending through zero and overflow wrap correctly.
+            using U = std::make_unsigned_t<T>;
+            return static_cast<T>(static_cast<U>(first) + static_cast<U>(i) * static_cast<U>(step));
+        }
+    };
+
+    /**
+     * \brief Lazy, read-only view over the elements of a list that was (partially) set using ranges. Elements are
+     * computed on access instead of being materialised.
+     */
+    template<typename T>
+    class list_view
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = T;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = T;
+
+            iterator() = default;
+
+            iterator(const list_segment<T>* segments, const std::vector<T>* literals, const size_t segment) :
+                segments(segments), literals(literals), segment(segment)
+            {
+            }
+
+            [[nodiscard]] T operator*() const { return segments[segment].at(index, *literals); }
+
+            iterator& operator++()
+            {
+                if (++index == segments[segment].count)
+                {
+                    segment++;
+                    index = 0;
+                }
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto it = *this;
+                ++*this;
+                return it;
+            }
+
+            [[nodiscard]] bool operator==(const iterator& other) const noexcept
+            {
+                return segment == other.segment && index == other.index;
+            }
+
+        private:
+            const list_segment<T>* segments = nullptr;
+            const std::vector<T>*  literals = nullptr;
+            size_t                 segment  = 0;
+            size_t                 index    = 0;
+        };
+
+        list_view(const std::vector<list_segment<T>>& segments, const std::vector<T>& literals, const size_t count) :
+            segments(&segments), literals(&literals), count(count)
+        {
+        }
+
+        /**
+         * \brief Get the total number of elements.
+         * \return Number of elements.
+         */
+        [[nodiscard]] size_t size() const noexcept { return count; }
+
+        [[nodiscard]] bool empty() const noexcept { return count == 0; }
+
+        /**
+         * \brief Compute the element at the given index. Complexity is logarithmic in the number of segments.
+         * \param i Index. Must be smaller than size().
+         * \return Element.
+         */
+        [[nodiscard]] T operator[](const size_t i) const
+        {
+            const auto it = std::ranges::upper_bound(*segments, i, {}, &list_segment<T>::offset) - 1;
+            return it->at(i - it->offset, *literals);
+        }
+
+        [[nodiscard]] iterator begin() const { return iterator(segments->data(), literals, 0); }
+
+        [[nodiscard]] iterator end() const { return iterator(segments->data(), literals, segments->size()); }
+
+    private:
+        const std::vector<list_segment<T>>* segments = nullptr;
+        const std::vector<T>*               literals = nullptr;
+        size_t                              count    = 0;
+    };
+}  // namespace pt
@@ -0,0 +1,259 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/argument.h"
+#include "parsertongue/flat_map.h"
+#include "parsertongue/list.h"
+#include "parsertongue/parsable.h"
+#include "parsertongue/parser_tongue_exception.h"
+#include "parsertongue/parse_error.h"
+#include "parsertongue/string_pool.h"
+
+namespace pt
+{
+    class parser;
+
+    /**
+     * \brief What a map does when the user passes a key that was already set.
+     */
+    enum class duplicate_policy : uint32_t
+    {
+        /**
+         * \brief The last value wins.
+         */
+        overwrite,
+
+        /**
+         * \brief The first value wins.
+         */
+        keep_first,
+
+        /**
+         * \brief Record a duplicate_key error and keep the first value.
+         */
+        reject
+    };
+
+    template<parsable K, parsable V>
+    class map;
+
+    template<parsable K, parsable V>
+    class map_state final : public argument_state
+    {
+    public:
+        friend class map<K, V>;
+
+        explicit map_state(const map<K, V>& m) : values(m.values), digests(m.digests), digest(m.digest) {}
+
+    private:
+        const flat_map<K, V>           values;
+        const std::vector<fingerprint> digests;
+        const fingerprint              digest;
+    };
+
+    /**
+     * \brief Argument that collects key-value pairs, e.g. -D name=value. Each element is split on the first
+     * separator, and key and value are converted separately. Like lists, maps can be passed multiple times and take
+     * multiple elements per argument.
+     * \tparam K Key type.
+     * \tparam V Value type.
+     */
+    template<parsable K, parsable V>
+    class map final : public base_list
+    {
+    public:
+        friend class parser;
+        friend class map_state<K, V>;
+
+        map() = delete;
+
+        map(const map&) = delete;
+
+        map(map&&) = delete;
+
+        map(const char short_name, std::string long_name) : base_list(short_name, std::move(long_name)) {}
+
+        ~map() noexcept override = default;
+
+        map& operator=(const map&) = delete;
+
+        map& operator=(map&&) = delete;
+
+        /**
+         * \brief Check if the map was set. Throws an exception if the parser was not run yet.
+         * \return True if the map was set, false otherwise.
+         */
+        [[nodiscard]] bool is_set() const
+        {
+            if (!valid) throw_exception("Cannot retrieve value before running the parser");
+            return has_value();
+        }
+
+        /**
+         * \brief Get the key-value pairs that were passed to this argument, in the order in which the keys were first
+         * passed. Throws an exception if the parser was not run yet or no values were set.
+         * \return Map.
+         */
+        [[nodiscard]] const flat_map<K, V>& get_values() const
+        {
+            if (!is_set()) throw_exception(std::format("{0} was not set", get_pretty_name()));
+            return values;
+        }
+
+        /**
+         * \brief Set the separator between key and value. Defaults to '='.
+         * \param c Separator.
+         */
+        void set_separator(const char c) noexcept { separator = c; }
+
+        /**
+         * \brief Set the delimiter that is used to split arguments into multiple pairs. Defaults to ','. Set to the
+         * null character to disable splitting.
+         * \param c Delimiter.
+         */
+        void set_delimiter(const char c) noexcept { delimiter = c; }
+
+        /**
+         * \brief Set what happens when a key is passed more than once. Defaults to overwrite.
+         * \param p Policy.
+         */
+        void set_duplicate_policy(const duplicate_policy p) noexcept { policy = p; }
+
+        void reset() override
+        {
+            base_list::reset();
+            values.clear();
+            digests.clear();
+            digest = {};
+        }
+
+    protected:
+        [[nodiscard]] argument_state_ptr save() const override { return std::make_shared<map_state<K, V>>(*this); }
+
+        void restore(const argument_state& state) override
+        {
+            const auto& s = static_cast<const map_state<K, V>&>(state);
+            values        = s.values;
+            digests       = s.digests;
+            digest        = s.digest;
+        }
+
+        [[nodiscard]] bool has_value() const noexcept override { return !values.empty(); }
+
+        [[nodiscard]] fingerprint get_fingerprint() const noexcept override { return digest; }
+
+        void parse(const std::string& arg, std::vector<parse_error_t>& parse_errors) noexcept override
+        {
+            detail::split(arg, delimiter, [&](const std::string& str) {
+                const auto sep = str.find(separator);
+                if (sep == std::string::npos)
+                {
+                    parse_errors.emplace_back(
+                      parse_error::parsing_error, arg, get_conversion_message(conversion_error::invalid_pair, str));
+                    return false;
+                }
+
+                const auto key_str = str.substr(0, sep);
+                const auto val_str = str.substr(sep + 1);
+                auto       key     = detail::parse_value<K>(key_str, pool);
+                if (!key)
+                {
+                    parse_errors.emplace_back(
+                      parse_error::parsing_error, arg, get_conversion_message(key.error(), key_str));
+                    return false;
+                }
+                auto val = detail::parse_value<V>(val_str, pool);
+                if (!val)
+                {
+                    parse_errors.emplace_back(
+                      parse_error::parsing_error, arg, get_conversion_message(val.error(), val_str));
+                    return false;
+                }
+
+                // The fingerprint is the sum of the hashes of all pairs, so that it does not depend on their order.
+                fingerprint_hasher hasher;
+                const auto         key_digest = detail::hash_value(*key, key_str);
+                const auto         val_digest = detail::hash_value(*val, val_str);
+                hasher.add(key_digest.low);
+                hasher.add(key_digest.high);
+                hasher.add(val_digest.low);
+                hasher.add(val_digest.high);
+                const auto pair_digest = hasher.digest();
+
+                const auto existing = values.find(*key);
+                if (existing == values.end())
+                {
+                    if (values.size() == max_elements)
+                    {
+                        parse_errors.emplace_back(
+                          parse_error::too_many_list_elements,
+                          arg,
+                          std::format("{0} cannot hold more than {1} elements", get_pretty_name(), max_elements));
+                        return false;
+                    }
+                    // Keep the digests in step with the values if either cannot grow.
+                    const auto insert = [&] {
+                        digests.push_back(pair_digest);
+                        values.try_emplace(std::move(*key), std::move(*val));
+                    };
+                    if (!detail::try_allocate(insert))
+                    {
+                        digests.resize(values.size());
+                        parse_errors.emplace_back(
+                          parse_error::too_many_list_elements,
+                          arg,
+                          std::format("{0} could not allocate memory for its elements", get_pretty_name()));
+                        return false;
+                    }
+                    digest += pair_digest;
+                }
+                else if (policy == duplicate_policy::overwrite)
+                {
+                    const auto i = static_cast<size_t>(existing - values.begin());
+                    values.insert_or_assign(std::move(*key), std::move(*val));
+                    digest -= digests[i];
+                    digests[i] = pair_digest;
+                    digest += pair_digest;
+                }
+                else if (policy == duplicate_policy::reject)
+                    parse_errors.emplace_back(
+                      parse_error::duplicate_key,
+                      arg,
+                      std::format("{0} was already passed to {1}", key_str, get_pretty_name()));
+                return true;
+            });
+        }
+
+    private:
+        flat_map<K, V> values;
+
+        /**
+         * \brief Hash of each pair, in the order of values.
+         */
+        std::vector<fingerprint> digests;
+
+        fingerprint digest;
+
+        duplicate_policy policy    = duplicate_policy::overwrite;
+        char             separator = '=';
+        char             delimiter = ',';
+    };
+
+    // Instantiated in the library for common types.
+    extern template class map_state<std::string, std::string>;
+    extern template class map<std::string, std::string>;
+}  // namespace pt
@@ -0,0 +1,221 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/parser.h"
+
+namespace pt
+{
+    /**
+     * \brief Immutable values of an option file at one point in time.
+     */
+    class option_snapshot
+    {
+    public:
+        friend class option_file;
+
+        option_snapshot() = default;
+
+        option_snapshot(const option_snapshot&) = delete;
+
+        option_snapshot(option_snapshot&&) = delete;
+
+        ~option_snapshot() = default;
+
+        option_snapshot& operator=(const option_snapshot&) = delete;
+
+        option_snapshot& operator=(option_snapshot&&) = delete;
+
+        /**
+         * \brief Get the number of the load that produced this snapshot, starting at 1.
+         * \return Version.
+         */
+        [[nodiscard]] uint64_t get_version() const noexcept { return version; }
+
+        /**
+         * \brief Get the result of parsing the file, including its operands.
+         * \return Result.
+         */
+        [[nodiscard]] const parse_result& get_result() const noexcept { return *result; }
+
+        /**
+         * \brief Get the value that was set in the file. Throws an exception if the value does not belong to the
+         * parser of the file.
+         * \tparam T Value type.
+         * \param v Value.
+         * \return Value, or std::nullopt if it was not set. Defaults are not included.
+         */
+        template<parsable T>
+        [[nodiscard]] const std::optional<T>& get(const std::shared_ptr<value<T>>& v) const
+        {
+            return state<value_state<T>>(*v).v;
+        }
+
+        /**
+         * \brief Check if a flag was set in the file. Throws an exception if the flag does not belong to the parser
+         * of the file.
+         * \param f Flag.
+         * \return True if the flag was set.
+         */
+        [[nodiscard]] bool is_set(const flag_ptr& f) const { return state<flag_state>(*f).value; }
+
+    private:
+        template<typename S>
+        [[nodiscard]] const S& state(const argument& arg) const
+        {
+            const auto* s = arg.index < states.size() ? dynamic_cast<const S*>(states[arg.index].get()) : nullptr;
+            if (!s) throw_exception("The argument does not belong to the parser of the option file");
+            return *s;
+        }
+
+        uint64_t                        version = 0;
+        parse_result_ptr                result;
+        std::vector<argument_state_ptr> states;
+
+        /**
+         * \brief Per argument, the fingerprint of its value if it was set. Compared to find changed arguments.
+         */
+        std::vector<std::optional<fingerprint>> digests;
+    };
+
+    using option_snapshot_ptr = std::shared_ptr<const option_snapshot>;
+
+    /**
+     * \brief Option source backed by a file that can be reloaded while the application is running. The file contains
+     * arguments as they would be passed on the command line, quoted and escaped like the input of a push_parser, and
+     * may span multiple lines. Lines starting with # are comments.
+     *
+     * Every load publishes a new immutable snapshot. Readers get the current snapshot without locking, and keep using
+     * it for as long as they hold it. After a snapshot was published, change callbacks are invoked for the arguments
+     * whose values differ from the previous snapshot. A file with parse errors is not published.
+     *
+     * Read values through snapshots only: the arguments of the parser are overwritten by every load. For the same
+     * reason, the parser should not have bound arguments.
+     */
+    class option_file
+    {
+    public:
+        using change_callback = std::function<void(const option_snapshot&)>;
+
+        using error_callback = std::function<void(const std::string&)>;
+
+        option_file() = delete;
+
+        /**
+         * \brief Construct a new option file. The file is not read until load is called.
+         * \param p Parser with all arguments added. Must not have been run.
+         * \param path Path of the file.
+         */
+        option_file(parser p, std::filesystem::path path);
+
+        option_file(const option_file&) = delete;
+
+        option_file(option_file&&) = delete;
+
+        /**
+         * \brief Stops watching the file.
+         */
+        ~option_file() noexcept;
+
+        option_file& operator=(const option_file&) = delete;
+
+        option_file& operator=(option_file&&) = delete;
+
+        /**
+         * \brief Invoke a callback whenever the value of an argument changes, including when it is first loaded.
+         * Callbacks are invoked by the thread that loads the file and must not load it again. Must be called before
+         * watching the file.
+         * \param arg Argument of the parser.
+         * \param callback Callback that receives the new snapshot.
+         */
+        void on_change(const argument_ptr& arg, change_callback callback);
+
+        /**
+         * \brief Invoke a callback when loading the file fails while it is watched. Must be called before watching
+         * the file.
+         * \param callback Callback that receives the error message.
+         */
+        void on_error(error_callback callback);
+
+        /**
+         * \brief Read and parse the file. If it is valid, publish a new snapshot and invoke the callbacks of the
+         * arguments that changed. Can be called while the file is watched.
+         * \param error Error string that is set when return value is false.
+         * \return False if the file could not be read or parsed. The current snapshot is kept.
+         */
+        bool load(std::string& error);
+
+        /**
+         * \brief Start watching the file on a background thread and load it whenever it changes. Uses inotify on
+         * Linux and falls back to polling the modification time elsewhere.
+         * \param interval Polling interval, and the longest time stop waits for the thread to finish.
+         */
+        void watch(std::chrono::milliseconds interval = std::chrono::milliseconds(500));
+
+        /**
+         * \brief Stop watching the file.
+         */
+        void stop() noexcept;
+
+        /**
+         * \brief Get the current snapshot. Does not wait for a load of the file that is in progress.
+         * \return Snapshot, or null if the file was not loaded yet.
+         */
+        [[nodiscard]] option_snapshot_ptr get() const noexcept;
+
+        [[nodiscard]] const std::filesystem::path& get_path() const noexcept;
+
+    private:
+        /**
+         * \brief Body of the watching thread.
+         */
+        void run(const std::stop_token& token, std::chrono::milliseconds interval);
+
+#ifdef __linux__
+        /**
+         * \brief Wait for changes with inotify.
+         * \return False if inotify is not available.
+         */
+        bool run_inotify(const std::stop_token& token, std::chrono::milliseconds interval);
+#endif
+
+        void run_polling(const std::stop_token& token, std::chrono::milliseconds interval);
+
+        /**
+         * \brief Load the file, reporting failures to the error callback.
+         */
+        void reload();
+
+        parser                                            p;
+        std::filesystem::path                             path;
+        std::vector<std::pair<size_t, change_callback>>   callbacks;
+        error_callback                                    error_handler;
+        std::atomic<option_snapshot_ptr>                  current;
+        uint64_t                                          loads = 0;
+
+        /**
+         * \brief Serializes loads.
+         */
+        std::mutex   mutex;
+        std::jthread watcher;
+    };
+}  // namespace pt
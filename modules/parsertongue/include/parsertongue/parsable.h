@@ -5,31 +5,81 @@
 ////////////////////////////////////////////////////////////////
 
 #include <concepts>
+#include <cstdint>
+#include <expected>
 #include <sstream>
 #include <string>
 #include <type_traits>
 
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/converter.h"
+#include "parsertongue/parser_tongue_exception.h"
+#include "parsertongue/parse_error.h"
+
 namespace pt
 {
     template<typename T>
-    concept parsable = std::convertible_to<T, std::string> || requires(T val, std::stringstream s)
+    concept parsable = has_converter<T> || std::convertible_to<T, std::string> || requires(T val, std::stringstream s)
     {
         {s >> val};
     };
 
+    /**
+     * \brief Convert a string to a value. Does not throw for invalid input.
+     * \tparam T Type.
+     * \param arg String.
+     * \return Value, or the reason the conversion failed.
+     */
     template<parsable T>
-    void parse_value(const std::string& arg, T& value)
+    std::expected<T, conversion_error> parse_value(const std::string& arg)
     {
+        // Target value has a converter, which takes precedence.
+        if constexpr (has_converter<T>)
+        {
+            T value{};
+            if (!converter<T>::parse(arg, value)) return std::unexpected(conversion_error::invalid_value);
+            return value;
+        }
         // Target value is string, assign directly.
-        if constexpr (std::is_same_v<T, std::string>) value = arg;
-        // Target value is concertible to string, cast.
-        else if constexpr (std::is_convertible_v<std::string, T>)
-            value = static_cast<T>(arg);
-        // Target value can be parsed from stringstream.
+        else if constexpr (std::is_same_v<T, std::string>)
+            return arg;
         else
         {
-            std::stringstream s(arg);
-            s >> value;
+#if PARSERTONGUE_EXCEPTIONS
+            // User types may still throw from their constructor or extraction operator.
+            try
+            {
+#endif
+                // Target value is concertible to string, cast.
+                if constexpr (std::is_convertible_v<std::string, T>)
+                    return static_cast<T>(arg);
+                // Target value can be parsed from stringstream.
+                else
+                {
+                    T                 value{};
+                    std::stringstream s(arg);
+                    if (!(s >> value)) return std::unexpected(conversion_error::invalid_value);
+                    return value;
+                }
+#if PARSERTONGUE_EXCEPTIONS
+            }
+            catch (std::exception&)
+            {
+                return std::unexpected(conversion_error::invalid_value);
+            }
+#endif
         }
     }
+
+    // Instantiated in the library for common types.
+    extern template std::expected<int, conversion_error> parse_value<int>(const std::string&);
+    extern template std::expected<int64_t, conversion_error> parse_value<int64_t>(const std::string&);
+    extern template std::expected<uint64_t, conversion_error> parse_value<uint64_t>(const std::string&);
+    extern template std::expected<double, conversion_error> parse_value<double>(const std::string&);
+    extern template std::expected<float, conversion_error> parse_value<float>(const std::string&);
+    extern template std::expected<bool, conversion_error> parse_value<bool>(const std::string&);
+    extern template std::expected<std::string, conversion_error> parse_value<std::string>(const std::string&);
 }  // namespace pt
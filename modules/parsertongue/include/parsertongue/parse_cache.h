@@ -0,0 +1,98 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/parse_result.h"
+
+namespace pt
+{
+    /**
+     * \brief Bounded, thread-safe least-recently-used cache of parse results, keyed on the list of arguments and the
+     * values of the environment variables that were read. A cache should only be shared between parsers that have
+     * the same arguments, added in the same order.
+     */
+    class parse_cache
+    {
+    public:
+        struct statistics
+        {
+            uint64_t hits      = 0;
+            uint64_t misses    = 0;
+            uint64_t evictions = 0;
+            size_t   size      = 0;
+        };
+
+        parse_cache() = delete;
+
+        /**
+         * \brief Construct a new cache.
+         * \param capacity Maximum number of results. Must be at least 1.
+         */
+        explicit parse_cache(size_t capacity);
+
+        parse_cache(const parse_cache&) = delete;
+
+        parse_cache(parse_cache&&) = delete;
+
+        ~parse_cache() = default;
+
+        parse_cache& operator=(const parse_cache&) = delete;
+
+        parse_cache& operator=(parse_cache&&) = delete;
+
+        /**
+         * \brief Look up the result for a list of arguments and mark it as most recently used. Results that read
+         * environment variables only match while the variables have the same values.
+         * \param arguments List of arguments.
+         * \return Result, or null on a miss.
+         */
+        [[nodiscard]] parse_result_ptr find(const std::vector<std::string>& arguments);
+
+        /**
+         * \brief Insert a result, evicting the least recently used result if the cache is full.
+         * \param result Result.
+         */
+        void insert(parse_result_ptr result);
+
+        /**
+         * \brief Remove all results. Statistics are kept.
+         */
+        void clear();
+
+        /**
+         * \brief Get the hit, miss and eviction counts and the current number of results.
+         * \return Statistics.
+         */
+        [[nodiscard]] statistics get_statistics() const;
+
+        /**
+         * \brief Hash a list of arguments.
+         * \param arguments List of arguments.
+         * \return Hash.
+         */
+        [[nodiscard]] static uint64_t hash(const std::vector<std::string>& arguments) noexcept;
+
+    private:
+        using entry_list = std::list<std::pair<uint64_t, parse_result_ptr>>;
+
+        size_t                                                     capacity;
+        entry_list                                                 entries;
+        std::unordered_multimap<uint64_t, entry_list::iterator>    lookup;
+        statistics                                                 stats;
+        mutable std::mutex                                         mutex;
+    };
+}  // namespace pt
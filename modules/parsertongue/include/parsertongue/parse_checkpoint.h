@@ -0,0 +1,78 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <memory>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/parse_result.h"
+
+namespace pt
+{
+    class parser;
+
+    /**
+     * \brief Immutable snapshot of a parser in the middle of parsing, after a prefix of arguments was processed but
+     * before the active value or list was closed and before the environment, validators and constraints were
+     * applied. Any number of suffixes can be parsed from a checkpoint, in any parser that has the same arguments,
+     * added in the same order, and the same limits.
+     */
+    class parse_checkpoint
+    {
+    public:
+        friend class parser;
+
+        parse_checkpoint() = default;
+
+        parse_checkpoint(const parse_checkpoint&) = delete;
+
+        parse_checkpoint(parse_checkpoint&&) = delete;
+
+        ~parse_checkpoint() = default;
+
+        parse_checkpoint& operator=(const parse_checkpoint&) = delete;
+
+        parse_checkpoint& operator=(parse_checkpoint&&) = delete;
+
+        /**
+         * \brief Get the prefix of arguments that was parsed.
+         * \return List of arguments.
+         */
+        [[nodiscard]] const std::vector<std::string>& get_arguments() const noexcept
+        {
+            return state->get_arguments();
+        }
+
+    private:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        /**
+         * \brief States of all arguments and of the parser. States are immutable and shared, so the converted values
+         * of the prefix are never converted again.
+         */
+        parse_result_ptr state;
+
+        /**
+         * \brief Index of the value that is waiting for its value, or npos.
+         */
+        size_t active_value = npos;
+
+        /**
+         * \brief Index of the list that is collecting values, or npos.
+         */
+        size_t active_list      = npos;
+        size_t positional_count = 0;
+        size_t token_count      = 0;
+        size_t total_length     = 0;
+        bool   stopped          = false;
+    };
+
+    using parse_checkpoint_ptr = std::shared_ptr<const parse_checkpoint>;
+}  // namespace pt
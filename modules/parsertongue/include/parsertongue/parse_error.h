@@ -18,7 +18,32 @@ namespace pt
         unknown_short_name,
         unknown_long_name,
         missing_value,
-        parsing_error
+        parsing_error,
+        unterminated_quote,
+        too_many_arguments,
+        argument_too_long,
+        input_too_large,
+        too_many_operands,
+        too_many_list_elements,
+        too_many_errors,
+        missing_required,
+        missing_dependency,
+        conflicting_arguments,
+        missing_one_of,
+        ambiguous_long_name,
+        validation_failed,
+        duplicate_key
+    };
+
+    /**
+     * \brief Reason why a string could not be converted to the value of an argument.
+     */
+    enum class conversion_error : uint32_t
+    {
+        invalid_value,
+        invalid_option,
+        invalid_range,
+        invalid_pair
     };
 
     /**
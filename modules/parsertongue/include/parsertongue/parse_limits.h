@@ -0,0 +1,56 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <limits>
+
+namespace pt
+{
+    /**
+     * \brief Limits that bound the time and memory spent on parsing untrusted input. By default, only the number of
+     * elements that a single range is expanded into is limited.
+     */
+    struct parse_limits
+    {
+        /**
+         * \brief Maximum number of arguments. Parsing stops with a too_many_arguments error when exceeded.
+         */
+        size_t max_arguments = std::numeric_limits<size_t>::max();
+
+        /**
+         * \brief Maximum length of a single argument. Parsing stops with an argument_too_long error when exceeded.
+         */
+        size_t max_argument_length = std::numeric_limits<size_t>::max();
+
+        /**
+         * \brief Maximum total length of all arguments. Parsing stops with an input_too_large error when exceeded.
+         */
+        size_t max_total_length = std::numeric_limits<size_t>::max();
+
+        /**
+         * \brief Maximum number of operands. Parsing stops with a too_many_operands error when exceeded.
+         */
+        size_t max_operands = std::numeric_limits<size_t>::max();
+
+        /**
+         * \brief Maximum number of elements per list. Excess elements are dropped with a too_many_list_elements error.
+         */
+        size_t max_list_elements = std::numeric_limits<size_t>::max();
+
+        /**
+         * \brief Maximum number of elements that a single range first-last[:step] is expanded into, by lists that
+         * store their elements individually. Larger ranges are rejected with a too_many_list_elements error. Lists
+         * with the default storage policy keep ranges lazy and are only bounded by max_list_elements.
+         */
+        size_t max_range_elements = size_t{1} << 20;
+
+        /**
+         * \brief Number of errors after which parsing stops with a too_many_errors error. Set to 1 to stop at the
+         * first error. Errors from the environment, validators and constraints are counted as well.
+         */
+        size_t max_errors = std::numeric_limits<size_t>::max();
+    };
+}  // namespace pt
@@ -0,0 +1,103 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/argument.h"
+#include "parsertongue/parse_error.h"
+
+namespace pt
+{
+    class option_file;
+    class parser;
+
+    /**
+     * \brief Immutable snapshot of everything a parser produced for a list of arguments. Can be restored into any
+     * parser that has the same arguments, added in the same order.
+     */
+    class parse_result
+    {
+    public:
+        friend class option_file;
+        friend class parser;
+
+        parse_result() = default;
+
+        parse_result(const parse_result&) = delete;
+
+        parse_result(parse_result&&) = delete;
+
+        ~parse_result() = default;
+
+        parse_result& operator=(const parse_result&) = delete;
+
+        parse_result& operator=(parse_result&&) = delete;
+
+        /**
+         * \brief Get the list of arguments that was parsed.
+         * \return List of arguments.
+         */
+        [[nodiscard]] const std::vector<std::string>& get_arguments() const noexcept { return arguments; }
+
+        /**
+         * \brief Get the list of all operands.
+         * \return List of strings.
+         */
+        [[nodiscard]] const std::vector<std::string>& get_operands() const noexcept { return operands; }
+
+        /**
+         * \brief Get the list of all errors that occurred during parsing.
+         * \return List of parse errors.
+         */
+        [[nodiscard]] const std::vector<parse_error_t>& get_errors() const noexcept { return parse_errors; }
+
+        /**
+         * \brief Get the environment variables that were read, sorted by name, and their values. Only filled in when
+         * the parser has a cache, which compares them to the current environment on a hit.
+         * \return List of variables. The value is empty if the variable was not set.
+         */
+        [[nodiscard]] const std::vector<std::pair<std::string, std::optional<std::string>>>&
+          get_environment() const noexcept
+        {
+            return environment;
+        }
+
+    private:
+        std::vector<std::string>        arguments;
+        std::vector<std::string>        operands;
+        std::vector<parse_error_t>      parse_errors;
+        std::vector<argument_state_ptr> states;
+        std::vector<value_source>       sources;
+
+        /**
+         * \brief Hash of the names and types of the arguments of the parser that produced this result, so that it is
+         * never restored into arguments of other types.
+         */
+        fingerprint layout;
+
+        /**
+         * \brief Environment variables that were read, sorted by name.
+         */
+        std::vector<std::pair<std::string, std::optional<std::string>>> environment;
+
+        /**
+         * \brief Values that were passed to arguments, for telemetry.
+         */
+        std::vector<std::pair<size_t, std::string>> observations;
+        bool                            requested_version = false;
+        bool                            requested_help    = false;
+    };
+
+    using parse_result_ptr = std::shared_ptr<const parse_result>;
+}  // namespace pt
@@ -4,8 +4,12 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <concepts>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -13,16 +17,52 @@
 // Current target includes.
 ////////////////////////////////////////////////////////////////
 
+#include "parsertongue/binding.h"
+#include "parsertongue/bytes.h"
+#include "parsertongue/constraints.h"
 #include "parsertongue/flag.h"
 #include "parsertongue/list.h"
+#include "parsertongue/map.h"
+#include "parsertongue/parse_checkpoint.h"
 #include "parsertongue/parse_error.h"
+#include "parsertongue/parse_limits.h"
+#include "parsertongue/parse_result.h"
 #include "parsertongue/value.h"
 
 namespace pt
 {
+    /**
+     * \brief Transparent hash that allows looking up long names by std::string_view without constructing a string.
+     */
+    struct name_hash
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] size_t operator()(const std::string_view name) const noexcept
+        {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    template<typename T>
+    using name_map = std::unordered_map<std::string, T, name_hash, std::equal_to<>>;
+
+    class column_batch;
+    class option_file;
+    class parse_cache;
+    class push_parser;
+    class recorder;
+    struct recording;
+    struct replay_report;
+    class telemetry;
+
     class parser
     {
     public:
+        friend class option_file;
+        friend class push_parser;
+        friend replay_report replay(parser& p, const recording& log, size_t iterations);
+
         parser() = delete;
 
         /**
@@ -70,6 +110,21 @@ namespace pt
          */
         void set_description(std::string app_description);
 
+        /**
+         * \brief Bind all arguments with a long name to environment variables named prefix + the upper case long
+         * name, e.g. APP_THREADS for --threads. Names set on arguments with argument::set_env take precedence. Values
+         * passed on the command line take precedence over the environment.
+         * \param prefix Prefix.
+         */
+        void set_env_prefix(std::string prefix);
+
+        /**
+         * \brief Allow the user to abbreviate long names to any unambiguous prefix, e.g. --verb for --verbose. Exact
+         * matches always take precedence. A prefix of multiple long names results in an ambiguous_long_name error.
+         * \param enabled If true, abbreviations are accepted.
+         */
+        void set_abbreviations(bool enabled);
+
         /**
          * \brief Add a new flag that can be set by the user with either -f or --long_name.
          * Passing already in use names will result in an exception.
@@ -102,6 +157,7 @@ namespace pt
          * \brief Add a new list that can be set by the user with either -f or --long_name.
          * Passing already in use names will result in an exception.
          * \tparam T Value type.
+         * \tparam S Storage policy of the list.
          * \param short_name Optional short name. Must be an alphabetic character. Set to null character to disable.
          * \param long_name Optional long name.
          * Must start with alphabetic character.
@@ -110,8 +166,226 @@ namespace pt
          * Leave empty to disable.
          * \return Pointer to list.
          */
+        template<typename T, list_storage S = vector_storage>
+        std::shared_ptr<list<T, S>> add_list(char short_name = '\0', const std::string& long_name = "");
+
+        /**
+         * \brief Add a new value that holds binary data, passed by the user as hex or base64 text. The text is decoded
+         * while parsing. Invalid text is recorded as a parsing_error with the offset of the first invalid character.
+         * Passing already in use names will result in an exception.
+         * \param short_name Optional short name. Must be an alphabetic character. Set to null character to disable.
+         * \param long_name Optional long name.
+         * \param encoding Encoding of the text.
+         * \return Pointer to value.
+         */
+        bytes_ptr add_bytes(char               short_name = '\0',
+                            const std::string& long_name  = "",
+                            binary_encoding    encoding   = binary_encoding::base64);
+
+        /**
+         * \brief Add a new map of key-value pairs that can be set by the user with either -f key=value or
+         * --long_name key=value. Passing already in use names will result in an exception.
+         * \tparam K Key type.
+         * \tparam V Value type.
+         * \param short_name Optional short name. Must be an alphabetic character. Set to null character to disable.
+         * \param long_name Optional long name.
+         * Must start with alphabetic character.
+         * Remaining characters can be alphabetic or underscores.
+         * Length must be at least 2.
+         * Leave empty to disable.
+         * \return Pointer to map.
+         */
+        template<typename K, typename V>
+        std::shared_ptr<map<K, V>> add_map(char short_name = '\0', const std::string& long_name = "");
+
+        /**
+         * \brief Add a new positional argument that is set by the operand at the next free position. Operands are
+         * converted when they are parsed and no longer returned by get_operands. Required positional arguments must be
+         * added before optional ones. A missing required operand is recorded as a missing_required error.
+         * \tparam T Value type.
+         * \param name Name that is displayed in the help and in errors. Must not be empty.
+         * \param required If true, the user must pass this operand.
+         * \return Pointer to value.
+         */
         template<typename T>
-        std::shared_ptr<list<T>> add_list(char short_name = '\0', const std::string& long_name = "");
+        std::shared_ptr<value<T>> add_operand(const std::string& name, bool required = true);
+
+        /**
+         * \brief Add a new list that receives all operands after the positional arguments. Can only be added once,
+         * after all positional arguments.
+         * \tparam T Value type.
+         * \tparam S Storage policy of the list.
+         * \param name Name that is displayed in the help and in errors. Must not be empty.
+         * \return Pointer to list.
+         */
+        template<typename T, list_storage S = vector_storage>
+        std::shared_ptr<list<T, S>> add_operands(const std::string& name);
+
+        /**
+         * \brief Add a new flag that sets a bool owned by the caller. The bool keeps its initial value unless the
+         * user passes the flag. Unlike add_flag, this does not allocate the flag separately. Passing already in use
+         * names will result in an exception.
+         * \param target Storage. Must outlive the parser.
+         * \param short_name Optional short name.
+         * \param long_name Optional long name.
+         * \return Pointer to flag.
+         */
+        flag_ptr bind_flag(bool& target, char short_name = '\0', const std::string& long_name = "");
+
+        /**
+         * \brief Add a new flag that sets a bit of an integer owned by the caller. Multiple flags can be bound to
+         * different bits of the same integer.
+         * \tparam I Integer type.
+         * \param bits Storage. Must outlive the parser.
+         * \param bit Position of the bit.
+         * \param short_name Optional short name.
+         * \param long_name Optional long name.
+         * \return Pointer to flag.
+         */
+        template<std::unsigned_integral I>
+            requires(!std::same_as<I, bool>)
+        flag_ptr bind_flag(I& bits, size_t bit, char short_name = '\0', const std::string& long_name = "");
+
+        /**
+         * \brief Add a new value that converts directly into storage owned by the caller. The storage keeps its
+         * initial value unless the user passes the value. Unlike add_value, this does not allocate the value
+         * separately or keep a copy of the result. Passing already in use names will result in an exception.
+         * \tparam T Value type.
+         * \param target Storage. Must outlive the parser.
+         * \param short_name Optional short name.
+         * \param long_name Optional long name.
+         * \return Pointer to value.
+         */
+        template<parsable T>
+        std::shared_ptr<bound_value<T>>
+          bind(T& target, char short_name = '\0', const std::string& long_name = "");
+
+        /**
+         * \brief Add a new value that converts directly into a member of an object owned by the caller.
+         * \tparam C Object type.
+         * \tparam T Value type.
+         * \param object Object. Must outlive the parser.
+         * \param member Pointer to member.
+         * \param short_name Optional short name.
+         * \param long_name Optional long name.
+         * \return Pointer to value.
+         */
+        template<typename C, parsable T>
+        std::shared_ptr<bound_value<T>>
+          bind(C& object, T C::*member, char short_name = '\0', const std::string& long_name = "");
+
+        /**
+         * \brief Add a new list that appends directly to a container owned by the caller, e.g. a std::vector or
+         * std::deque. Elements already in the container are kept. Passing already in use names will result in an
+         * exception.
+         * \tparam C Container type.
+         * \param target Container. Must outlive the parser.
+         * \param short_name Optional short name.
+         * \param long_name Optional long name.
+         * \return Pointer to list.
+         */
+        template<appendable C>
+        std::shared_ptr<bound_list<C>>
+          bind_list(C& target, char short_name = '\0', const std::string& long_name = "");
+
+        /**
+         * \brief Add a new list that appends directly to a container member of an object owned by the caller.
+         * \tparam C Object type.
+         * \tparam L Container type.
+         * \param object Object. Must outlive the parser.
+         * \param member Pointer to member.
+         * \param short_name Optional short name.
+         * \param long_name Optional long name.
+         * \return Pointer to list.
+         */
+        template<typename C, appendable L>
+        std::shared_ptr<bound_list<L>>
+          bind_list(C& object, L C::*member, char short_name = '\0', const std::string& long_name = "");
+
+        /**
+         * \brief Require that the user passes all of the arguments. Violations are recorded as missing_required errors.
+         * \param args Arguments.
+         */
+        void add_required(const std::vector<argument_ptr>& args);
+
+        /**
+         * \brief Require that the user passes all of the arguments when passing the trigger argument. Violations are
+         * recorded as missing_dependency errors.
+         * \param trigger Trigger argument.
+         * \param args Arguments.
+         */
+        void add_dependency(const argument_ptr& trigger, const std::vector<argument_ptr>& args);
+
+        /**
+         * \brief Allow the user to pass at most one of the arguments. Violations are recorded as conflicting_arguments
+         * errors.
+         * \param args Arguments.
+         */
+        void add_conflict(const std::vector<argument_ptr>& args);
+
+        /**
+         * \brief Require that the user passes exactly one of the arguments. Violations are recorded as
+         * conflicting_arguments or missing_one_of errors.
+         * \param args Arguments.
+         */
+        void add_exactly_one_of(const std::vector<argument_ptr>& args);
+
+        /**
+         * \brief Require that the user passes at least one of the arguments. Violations are recorded as missing_one_of
+         * errors.
+         * \param args Arguments.
+         */
+        void add_at_least_one_of(const std::vector<argument_ptr>& args);
+
+        /**
+         * \brief Set the limits that bound the time and memory spent on parsing. Exceeding a limit results in a
+         * parse error of the corresponding type and, except for list elements, stops parsing.
+         * \param parse_limits Limits.
+         */
+        void set_limits(const parse_limits& parse_limits);
+
+        /**
+         * \brief Get the limits.
+         * \return Limits.
+         */
+        [[nodiscard]] const parse_limits& get_limits() const noexcept;
+
+        /**
+         * \brief Set a cache that is used to look up the results of previous runs with the same arguments and the same
+         * values of the environment variables that were read. On a hit, the cached result is restored into all
+         * arguments instead of parsing. The cache should only be shared
+         * between parsers that have the same arguments, added in the same order, and the same limits.
+         * \param parse_cache Cache. Pass null to disable caching.
+         */
+        void set_cache(std::shared_ptr<parse_cache> parse_cache);
+
+        /**
+         * \brief Set the pool into which values and lists of interned_string intern their strings. The pool can be
+         * shared between parsers and parses. Without a pool, the global pool is used.
+         * \param string_pool Pool.
+         */
+        void set_string_pool(std::shared_ptr<string_pool> string_pool);
+
+        /**
+         * \brief Set a sink that aggregates which arguments, values and errors occur across parses. The sink should
+         * only be shared between parsers that have the same arguments, added in the same order.
+         * \param sink Sink. Pass null to disable telemetry.
+         */
+        void set_telemetry(std::shared_ptr<telemetry> sink);
+
+        /**
+         * \brief Set a batch into which the values of its columns are appended as a row after every run. All columns
+         * must belong to arguments of this parser.
+         * \param batch Batch. Pass null to disable.
+         */
+        void set_batch(std::shared_ptr<column_batch> batch);
+
+        /**
+         * \brief Set a recorder to which the arguments and outcome of every run are appended. The recorder should
+         * only be shared between parsers that have the same arguments, added in the same order.
+         * \param rec Recorder. Pass null to disable recording.
+         */
+        void set_recorder(std::shared_ptr<recorder> rec);
 
         /**
          * \brief Get the list of arguments that was passed by the user.
@@ -147,11 +421,27 @@ namespace pt
         void display_errors(std::ostream& out) const;
 
         /**
-         * \brief Get the list of all operands (values not belonging to an argument) that were passed by the user.
+         * \brief Get the list of all operands (values not belonging to an argument or positional argument) that were passed by the user.
          * \return List of strings.
          */
         [[nodiscard]] const std::vector<std::string>& get_operands() const;
 
+        /**
+         * \brief Get an immutable snapshot of the result of running the parser. When a cache is set, this is the
+         * shared result that is stored in the cache.
+         * \return Result.
+         */
+        [[nodiscard]] parse_result_ptr get_result() const;
+
+        /**
+         * \brief Get a hash of the parsed values that can be used as a cache key. The fingerprint combines the names
+         * and converted values of all arguments that were set and the list of operands. It does not depend on the
+         * order of arguments, on how names and values were spelled or on repetition of arguments. Defaults are not
+         * included. Arguments can be excluded with argument::set_fingerprint.
+         * \return Fingerprint.
+         */
+        [[nodiscard]] fingerprint get_fingerprint() const;
+
         /**
          * \brief Run the parser.
          * \param error Error string that is set when return value is false.
@@ -167,38 +457,234 @@ namespace pt
          */
         void reset(const std::string& args, bool noProgramName);
 
+        /**
+         * \brief Reset the parser with a new list of arguments. All arguments are reset as well. Parser must be run again.
+         * \param args List of arguments, not including the program name.
+         */
+        void reset(std::vector<std::string> args);
+
+        /**
+         * \brief Parse a prefix that is shared by many lists of arguments into a checkpoint. The active value or list
+         * is kept open, so the prefix may end in the middle of a list or with a name whose value follows in the
+         * suffix. Callbacks set with set_callback are invoked for the arguments of the prefix now, not when
+         * resuming. The parser is reset afterwards.
+         * \param prefix List of arguments, not including the program name.
+         * \return Checkpoint.
+         */
+        [[nodiscard]] parse_checkpoint_ptr make_checkpoint(std::vector<std::string> prefix);
+
+        /**
+         * \brief Reset the parser to continue from a checkpoint with a suffix of arguments. All arguments are reset as
+         * well. Parser must be run again. The outcome is identical to parsing the prefix followed by the suffix from
+         * scratch, but the prefix is not parsed again.
+         * \param checkpoint Checkpoint created by a parser with the same arguments, added in the same order.
+         * \param suffix List of arguments that follow the prefix.
+         */
+        void reset(parse_checkpoint_ptr checkpoint, std::vector<std::string> suffix);
+
     private:
         void run();
 
+        /**
+         * \brief Prepare all arguments for parsing.
+         */
+        void begin();
+
+        /**
+         * \brief Throw an exception if the derived default of a value depends on an argument of another parser.
+         * \param v Value.
+         */
+        void check_dependencies(const base_value& v) const;
+
+        /**
+         * \brief Hash the names and types of all arguments into layout, if arguments were added since the last call.
+         */
+        void update_layout();
+
+        /**
+         * \brief Process a single argument. All state is kept in members, so parsing can be resumed at any argument.
+         * \param arg Argument.
+         * \return False if no further arguments should be processed.
+         */
+        bool step(const std::string& arg);
+
+        /**
+         * \brief Process a single argument after all limits were checked.
+         * \param arg Argument.
+         */
+        void process(const std::string& arg);
+
+        /**
+         * \brief Close the currently active value or list.
+         */
+        void end();
+
+        /**
+         * \brief Parse a string into a value or list, recording it for telemetry if enabled.
+         * \param arg Value or list.
+         * \param str String.
+         */
+        template<typename A>
+        void parse_argument(A& arg, const std::string& str);
+
+        /**
+         * \brief Pass the outcome of the parse to the telemetry sink and the batch, if any.
+         */
+        void record();
+
+        /**
+         * \brief Notify that an argument received its value(s).
+         * \param arg Argument.
+         */
+        void complete(argument& arg);
+
+        /**
+         * \brief Replace what an argument contributes to the fingerprint by its current value.
+         * \param arg Argument.
+         */
+        void update_fingerprint(argument& arg);
+
+        /**
+         * \brief Read the values of arguments that were not passed on the command line from their bound environment
+         * variables, in a single scan over the environment.
+         */
+        void parse_env();
+
+        /**
+         * \brief Record an error for an exceeded limit and stop parsing.
+         * \param error Error type.
+         * \param arg Argument. Truncated to the maximum argument length.
+         * \param message Error message.
+         */
+        void stop(parse_error error, const std::string& arg, std::string message);
+
+        /**
+         * \brief Stop parsing with a too_many_errors error if the maximum number of errors was reached.
+         * \param arg Argument that was processed last.
+         */
+        void check_errors(const std::string& arg);
+
+        /**
+         * \brief Create a snapshot of the current state of the parser and all arguments.
+         * \return Result.
+         */
+        [[nodiscard]] parse_result_ptr save() const;
+
+        /**
+         * \brief Restore the state of the parser and all arguments from a snapshot.
+         * \param result Result.
+         */
+        void restore(const parse_result& result);
+
+        /**
+         * \brief Restore the state of the parser and all arguments from a checkpoint, including the active value or
+         * list.
+         * \param checkpoint Checkpoint.
+         */
+        void restore(const parse_checkpoint& checkpoint);
+
         void
           check_names(char short_name, const std::string& long_name, bool& use_short_name, bool& use_long_name) const;
 
-        void parse_short_name(const std::string& arg, value_ptr& active_value, list_ptr& active_list);
+        void parse_short_name(const std::string& arg);
+
+        void parse_long_name(const std::string& arg);
 
-        void parse_long_name(const std::string& arg, value_ptr& active_value, list_ptr& active_list);
+        /**
+         * \brief Find all long names that start with a prefix.
+         * \param prefix Prefix.
+         * \return Range of matching names in long_names.
+         */
+        [[nodiscard]] std::pair<std::vector<std::string_view>::const_iterator,
+                                std::vector<std::string_view>::const_iterator>
+          find_abbreviation(std::string_view prefix) const;
+
+        /**
+         * \brief Create an argument in the arena. The returned pointer shares ownership of the arena.
+         */
+        template<typename A, typename... Args>
+        std::shared_ptr<A> create_bound(Args&&... args);
+
+        /**
+         * \brief Create a flag in the arena and register it.
+         */
+        flag_ptr add_bound_flag(void*              target,
+                                uint64_t           mask,
+                                bool               initial,
+                                void (*store)(void*, uint64_t, bool) noexcept,
+                                char               short_name,
+                                const std::string& long_name);
+
+        /**
+         * \brief Verify that a positional argument can be added.
+         * \param name Name.
+         */
+        void check_operand(const std::string& name) const;
+
+        /**
+         * \brief Add a constraint after verifying that all arguments belong to this parser.
+         */
+        void add_constraint(constraints::type type, const argument_ptr& trigger, const std::vector<argument_ptr>& args);
 
         bool                                       parsed = false;
         std::string                                name;
         std::string                                version;
         std::string                                description;
+        std::string                                env_prefix;
+        bool                                       abbreviations = false;
         std::vector<std::string>                   arguments;
         std::vector<argument_ptr>                  argument_objects;
+        constraints                                argument_constraints;
         std::unordered_map<char, flag_ptr>         flags;
-        std::unordered_map<std::string, flag_ptr>  flags_long;
+        name_map<flag_ptr>                         flags_long;
         std::unordered_map<char, value_ptr>        values;
-        std::unordered_map<std::string, value_ptr> values_long;
+        name_map<value_ptr>                        values_long;
         std::unordered_map<char, list_ptr>         lists;
-        std::unordered_map<std::string, list_ptr>  lists_long;
+        name_map<list_ptr>                         lists_long;
+        std::vector<std::string_view>              long_names;
+        fingerprint                                layout;
+        size_t                                     layout_size = 0;
+        std::vector<value_ptr>                     positionals;
+        size_t                                     required_positionals = 0;
+        list_ptr                                   positional_tail;
+        size_t                                     positional_count = 0;
         std::vector<std::string>                   operands;
+        fingerprint                                fingerprint_sum;
+        fingerprint_hasher                         operand_hasher;
         std::vector<parse_error_t>                 parse_errors;
         bool                                       requested_version = false;
         bool                                       requested_help    = false;
+        bool                                       stopped           = false;
+        size_t                                     token_count       = 0;
+        size_t                                     total_length      = 0;
+        parse_limits                               limits;
+        value_ptr                                  active_value;
+        list_ptr                                   active_list;
+        std::function<void(const argument&)>       on_complete;
+        std::shared_ptr<parse_cache>               cache;
+        std::shared_ptr<string_pool>               pool;
+        std::shared_ptr<detail::argument_arena>    arena;
+        std::shared_ptr<telemetry>                 telemetry_sink;
+        std::shared_ptr<column_batch>              batch_sink;
+        std::shared_ptr<recorder>                  recording_sink;
+        std::vector<std::pair<size_t, std::string>> observations;
+        mutable parse_result_ptr                   result;
+
+        /**
+         * \brief Environment variables that were read, for the cache.
+         */
+        std::vector<std::pair<std::string, std::optional<std::string>>> environment;
+
+        /**
+         * \brief Checkpoint to continue from when running, set by reset.
+         */
+        parse_checkpoint_ptr resume_point;
     };
 
     template<typename T>
     std::shared_ptr<value<T>> parser::add_value(const char short_name, const std::string& long_name)
     {
-        if (parsed) throw parser_tongue_exception("Cannot add value after running the parser");
+        if (parsed) throw_exception("Cannot add value after running the parser");
 
         auto use_short = false;
         auto use_long  = false;
@@ -207,6 +693,7 @@ namespace pt
 
         // Create and store value.
         auto ptr = std::make_shared<value<T>>(short_name, long_name);
+        ptr->index = argument_objects.size();
         argument_objects.push_back(ptr);
         if (use_short) values[short_name] = ptr;
         if (use_long) values_long[long_name] = ptr;
@@ -214,10 +701,108 @@ namespace pt
         return ptr;
     }
 
+    template<typename T, list_storage S>
+    std::shared_ptr<list<T, S>> parser::add_list(const char short_name, const std::string& long_name)
+    {
+        if (parsed) throw_exception("Cannot add list after running the parser");
+
+        auto use_short = false;
+        auto use_long  = false;
+
+        check_names(short_name, long_name, use_short, use_long);
+
+        // Create and store value.
+        auto ptr = std::make_shared<list<T, S>>(short_name, long_name);
+        ptr->index = argument_objects.size();
+        argument_objects.push_back(ptr);
+        if (use_short) lists[short_name] = ptr;
+        if (use_long) lists_long[long_name] = ptr;
+
+        return ptr;
+    }
+
+    template<typename K, typename V>
+    std::shared_ptr<map<K, V>> parser::add_map(const char short_name, const std::string& long_name)
+    {
+        if (parsed) throw_exception("Cannot add map after running the parser");
+
+        auto use_short = false;
+        auto use_long  = false;
+
+        check_names(short_name, long_name, use_short, use_long);
+
+        // Create and store map. Maps are parsed like lists.
+        auto ptr = std::make_shared<map<K, V>>(short_name, long_name);
+        ptr->index = argument_objects.size();
+        argument_objects.push_back(ptr);
+        if (use_short) lists[short_name] = ptr;
+        if (use_long) lists_long[long_name] = ptr;
+
+        return ptr;
+    }
+
     template<typename T>
-    std::shared_ptr<list<T>> parser::add_list(const char short_name, const std::string& long_name)
+    std::shared_ptr<value<T>> parser::add_operand(const std::string& name, const bool required)
+    {
+        check_operand(name);
+        if (required && required_positionals != positionals.size())
+            throw_exception("Required operands must be added before optional operands");
+
+        // Create and store value.
+        auto ptr        = std::make_shared<value<T>>('\0', name);
+        ptr->index      = argument_objects.size();
+        ptr->positional = true;
+        argument_objects.push_back(ptr);
+        positionals.push_back(ptr);
+
+        if (required)
+        {
+            required_positionals++;
+            argument_constraints.add(constraints::type::required, nullptr, {ptr.get()});
+        }
+
+        return ptr;
+    }
+
+    template<typename T, list_storage S>
+    std::shared_ptr<list<T, S>> parser::add_operands(const std::string& name)
+    {
+        check_operand(name);
+
+        // Create and store list. Each operand is a single element, so disable splitting.
+        auto ptr        = std::make_shared<list<T, S>>('\0', name);
+        ptr->index      = argument_objects.size();
+        ptr->positional = true;
+        ptr->set_delimiter('\0');
+        argument_objects.push_back(ptr);
+        positional_tail = ptr;
+
+        return ptr;
+    }
+
+    template<std::unsigned_integral I>
+        requires(!std::same_as<I, bool>)
+    flag_ptr parser::bind_flag(I& bits, const size_t bit, const char short_name, const std::string& long_name)
+    {
+        if (bit >= sizeof(I) * 8) throw_exception("Bit position is out of range");
+
+        const auto mask = uint64_t{1} << bit;
+        return add_bound_flag(
+          &bits,
+          mask,
+          (static_cast<uint64_t>(bits) & mask) != 0,
+          [](void* target, const uint64_t m, const bool value) noexcept {
+              auto& b = *static_cast<I*>(target);
+              b       = value ? static_cast<I>(b | static_cast<I>(m)) : static_cast<I>(b & static_cast<I>(~m));
+          },
+          short_name,
+          long_name);
+    }
+
+    template<parsable T>
+    std::shared_ptr<bound_value<T>> parser::bind(T& target, const char short_name, const std::string& long_name)
     {
-        if (parsed) throw parser_tongue_exception("Cannot add list after running the parser");
+        if (parsed) throw_exception("Cannot add value after running the parser");
 
         auto use_short = false;
         auto use_long  = false;
@@ -225,11 +810,85 @@ namespace pt
         check_names(short_name, long_name, use_short, use_long);
 
         // Create and store value.
-        auto ptr = std::make_shared<list<T>>(short_name, long_name);
+        auto ptr   = create_bound<bound_value<T>>(short_name, long_name, target);
+        ptr->index = argument_objects.size();
+        argument_objects.push_back(ptr);
+        if (use_short) values[short_name] = ptr;
+        if (use_long) values_long[long_name] = ptr;
+
+        return ptr;
+    }
+
+    template<typename C, parsable T>
+    std::shared_ptr<bound_value<T>>
+      parser::bind(C& object, T C::*member, const char short_name, const std::string& long_name)
+    {
+        return bind(object.*member, short_name, long_name);
+    }
+
+    template<appendable C>
+    std::shared_ptr<bound_list<C>> parser::bind_list(C& target, const char short_name, const std::string& long_name)
+    {
+        if (parsed) throw_exception("Cannot add list after running the parser");
+
+        auto use_short = false;
+        auto use_long  = false;
+
+        check_names(short_name, long_name, use_short, use_long);
+
+        // Create and store list.
+        auto ptr   = create_bound<bound_list<C>>(short_name, long_name, target);
+        ptr->index = argument_objects.size();
         argument_objects.push_back(ptr);
         if (use_short) lists[short_name] = ptr;
         if (use_long) lists_long[long_name] = ptr;
 
         return ptr;
     }
+
+    template<typename C, appendable L>
+    std::shared_ptr<bound_list<L>>
+      parser::bind_list(C& object, L C::*member, const char short_name, const std::string& long_name)
+    {
+        return bind_list(object.*member, short_name, long_name);
+    }
+
+    template<typename A, typename... Args>
+    std::shared_ptr<A> parser::create_bound(Args&&... args)
+    {
+        if (!arena) arena = std::make_shared<detail::argument_arena>();
+        return std::shared_ptr<A>(arena, arena->create<A>(std::forward<Args>(args)...));
+    }
+
+    // Instantiated in the library for common types.
+    extern template std::shared_ptr<value<int>> parser::add_value<int>(char, const std::string&);
+    extern template std::shared_ptr<list<int>> parser::add_list<int>(char, const std::string&);
+    extern template std::shared_ptr<value<int>> parser::add_operand<int>(const std::string&, bool);
+    extern template std::shared_ptr<list<int>> parser::add_operands<int>(const std::string&);
+    extern template std::shared_ptr<value<int64_t>> parser::add_value<int64_t>(char, const std::string&);
+    extern template std::shared_ptr<list<int64_t>> parser::add_list<int64_t>(char, const std::string&);
+    extern template std::shared_ptr<value<int64_t>> parser::add_operand<int64_t>(const std::string&, bool);
+    extern template std::shared_ptr<list<int64_t>> parser::add_operands<int64_t>(const std::string&);
+    extern template std::shared_ptr<value<uint64_t>> parser::add_value<uint64_t>(char, const std::string&);
+    extern template std::shared_ptr<list<uint64_t>> parser::add_list<uint64_t>(char, const std::string&);
+    extern template std::shared_ptr<value<uint64_t>> parser::add_operand<uint64_t>(const std::string&, bool);
+    extern template std::shared_ptr<list<uint64_t>> parser::add_operands<uint64_t>(const std::string&);
+    extern template std::shared_ptr<value<double>> parser::add_value<double>(char, const std::string&);
+    extern template std::shared_ptr<list<double>> parser::add_list<double>(char, const std::string&);
+    extern template std::shared_ptr<value<double>> parser::add_operand<double>(const std::string&, bool);
+    extern template std::shared_ptr<list<double>> parser::add_operands<double>(const std::string&);
+    extern template std::shared_ptr<value<float>> parser::add_value<float>(char, const std::string&);
+    extern template std::shared_ptr<list<float>> parser::add_list<float>(char, const std::string&);
+    extern template std::shared_ptr<value<float>> parser::add_operand<float>(const std::string&, bool);
+    extern template std::shared_ptr<list<float>> parser::add_operands<float>(const std::string&);
+    extern template std::shared_ptr<value<bool>> parser::add_value<bool>(char, const std::string&);
+    extern template std::shared_ptr<list<bool>> parser::add_list<bool>(char, const std::string&);
+    extern template std::shared_ptr<value<bool>> parser::add_operand<bool>(const std::string&, bool);
+    extern template std::shared_ptr<list<bool>> parser::add_operands<bool>(const std::string&);
+    extern template std::shared_ptr<value<std::string>> parser::add_value<std::string>(char, const std::string&);
+    extern template std::shared_ptr<list<std::string>> parser::add_list<std::string>(char, const std::string&);
+    extern template std::shared_ptr<value<std::string>> parser::add_operand<std::string>(const std::string&, bool);
+    extern template std::shared_ptr<list<std::string>> parser::add_operands<std::string>(const std::string&);
+    extern template std::shared_ptr<map<std::string, std::string>>
+      parser::add_map<std::string, std::string>(char, const std::string&);
 }  // namespace pt
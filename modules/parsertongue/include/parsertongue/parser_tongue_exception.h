@@ -5,7 +5,16 @@
 ////////////////////////////////////////////////////////////////
 
 #include <exception>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <utility>
+
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+#define PARSERTONGUE_EXCEPTIONS 1
+#else
+#define PARSERTONGUE_EXCEPTIONS 0
+#endif
 
 namespace pt
 {
@@ -18,4 +27,68 @@ namespace pt
     private:
         std::string message;
     };
-}
\ No newline at end of file
+
+    /**
+     * \brief Throw a parser_tongue_exception. Used for programmer errors only. If the library was built without
+     * exceptions, the message is written to stderr and the program is aborted instead.
+     * \param message Message.
+     */
+    [[noreturn]] void throw_exception(std::string message);
+
+    namespace detail
+    {
+        /**
+         * \brief Invoke f, catching any exception it throws. Without exceptions, f is simply invoked.
+         * \param f Function.
+         * \param error Set to the message of the exception.
+         * \return False if an exception was caught, otherwise the return value of f.
+         */
+        template<typename F>
+        bool guard(F&& f, std::string& error)
+        {
+#if PARSERTONGUE_EXCEPTIONS
+            try
+            {
+                return std::forward<F>(f)();
+            }
+            catch (std::exception& e)
+            {
+                error = e.what();
+                return false;
+            }
+#else
+            static_cast<void>(error);
+            return std::forward<F>(f)();
+#endif
+        }
+
+        /**
+         * \brief Invoke f, which allocates memory, in a context that must not throw. Without exceptions, a failed
+         * allocation terminates the program instead.
+         * \param f Function.
+         * \return False if f could not allocate memory.
+         */
+        template<typename F>
+        bool try_allocate(F&& f) noexcept
+        {
+#if PARSERTONGUE_EXCEPTIONS
+            try
+            {
+                std::forward<F>(f)();
+                return true;
+            }
+            catch (const std::bad_alloc&)
+            {
+                return false;
+            }
+            catch (const std::length_error&)
+            {
+                return false;
+            }
+#else
+            std::forward<F>(f)();
+            return true;
+#endif
+        }
+    }  // namespace detail
+}
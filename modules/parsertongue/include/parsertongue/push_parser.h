@@ -0,0 +1,103 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/parser.h"
+
+namespace pt
+{
+    /**
+     * \brief Incremental front-end for a parser. Input can be fed in arbitrary fragments of bytes or as complete
+     * arguments. Each argument is processed as soon as it is complete, so the values of arguments can be inspected
+     * before all input has been received. Once the parser stops, e.g. because a limit was exceeded or help was
+     * requested, further input is discarded without being buffered.
+     */
+    class push_parser
+    {
+    public:
+        push_parser() = delete;
+
+        /**
+         * \brief Construct a new push parser. Arguments that were already passed to the parser are processed
+         * immediately. The parser counts as run: it cannot be invoked or be modified afterwards.
+         * \param p Parser with all arguments added. Must outlive the push parser.
+         */
+        explicit push_parser(parser& p);
+
+        push_parser(const push_parser&) = delete;
+
+        push_parser(push_parser&&) = delete;
+
+        ~push_parser() = default;
+
+        push_parser& operator=(const push_parser&) = delete;
+
+        push_parser& operator=(push_parser&&) = delete;
+
+        /**
+         * \brief Set a callback that is invoked whenever an argument received its value(s). Flags and values
+         * complete immediately, lists when the next argument name or the end of input is reached.
+         * \param callback Callback.
+         */
+        void set_callback(std::function<void(const argument&)> callback);
+
+        /**
+         * \brief Feed a fragment of the argument string. Arguments are separated by whitespace. Single and double
+         * quotes group whitespace into an argument and, outside of single quotes, a backslash escapes the next
+         * character. Fragments may split arguments, quotes and escapes at any position.
+         * \param bytes Fragment.
+         * \param error Error string that is set when return value is false.
+         * \return False if there were internal errors and parsing failed.
+         */
+        bool feed(std::string_view bytes, std::string& error);
+
+        /**
+         * \brief Feed a single, complete argument. Does not interact with partial input passed to feed.
+         * \param arg Argument.
+         * \param error Error string that is set when return value is false.
+         * \return False if there were internal errors and parsing failed.
+         */
+        bool feed_argument(std::string arg, std::string& error);
+
+        /**
+         * \brief Signal the end of input. Completes the last argument and the active list. Nothing can be fed
+         * afterwards.
+         * \param error Error string that is set when return value is false.
+         * \return False if there were internal errors and parsing failed.
+         */
+        bool finish(std::string& error);
+
+        /**
+         * \brief Check if finish was called.
+         * \return True if finished.
+         */
+        [[nodiscard]] bool is_finished() const noexcept;
+
+    private:
+        /**
+         * \brief Check if the parser stopped processing arguments.
+         */
+        [[nodiscard]] bool is_stopped() const noexcept;
+
+        void append(char c);
+
+        void push(std::string arg);
+
+        parser&     target;
+        std::string token;
+        bool        in_token = false;
+        bool        escape   = false;
+        char        quote    = '\0';
+        bool        finished = false;
+    };
+}  // namespace pt
@@ -0,0 +1,243 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/argument.h"
+#include "parsertongue/fingerprint.h"
+#include "parsertongue/parse_error.h"
+
+namespace pt
+{
+    class parser;
+
+    /**
+     * \brief One parse read back from a recording.
+     */
+    struct recorded_parse
+    {
+        std::vector<std::string> arguments;
+
+        /**
+         * \brief Kinds of the errors, in the order in which they occurred.
+         */
+        std::vector<parse_error> errors;
+
+        /**
+         * \brief Indices of the arguments that were passed on the command line, in ascending order.
+         */
+        std::vector<uint32_t> used;
+
+        [[nodiscard]] bool operator==(const recorded_parse&) const = default;
+    };
+
+    /**
+     * \brief Contents of a recording file.
+     */
+    struct recording
+    {
+        /**
+         * \brief Hash of the names of the arguments of the recording parser. Replaying requires a parser with the
+         * same arguments, added in the same order.
+         */
+        fingerprint layout;
+
+        std::vector<recorded_parse> parses;
+    };
+
+    /**
+     * \brief Outcome of replaying a recording.
+     */
+    struct replay_report
+    {
+        /**
+         * \brief Number of timed parses, over all iterations.
+         */
+        uint64_t parses = 0;
+
+        /**
+         * \brief Total time spent in the parser.
+         */
+        std::chrono::nanoseconds elapsed{0};
+
+        std::chrono::nanoseconds p50{0};
+        std::chrono::nanoseconds p90{0};
+        std::chrono::nanoseconds p99{0};
+        std::chrono::nanoseconds max{0};
+
+        /**
+         * \brief Indices of the recorded parses whose errors or used arguments differ from the recording.
+         */
+        std::vector<size_t> mismatches;
+
+        /**
+         * \brief Get the number of parses per second.
+         * \return Throughput.
+         */
+        [[nodiscard]] double get_throughput() const noexcept;
+
+        /**
+         * \brief Format as a JSON object.
+         * \return String.
+         */
+        [[nodiscard]] std::string to_json() const;
+    };
+
+    /**
+     * \brief Opt-in sink that appends the arguments and outcome of every parse to a compact binary log, so that real
+     * invocations can be replayed offline to find performance and behavior regressions. Records are encoded without
+     * locking and written in large blocks. Once the file reaches its maximum size, further parses are dropped. Share
+     * a recorder only between parsers that have the same arguments, added in the same order.
+     *
+     * Values read from the environment are not recorded. Replay in an environment without the variables of the
+     * parser, or expect mismatches for parses that used them.
+     */
+    class recorder
+    {
+    public:
+        friend class parser;
+        friend replay_report replay(parser& p, const recording& log, size_t iterations);
+
+        recorder() = delete;
+
+        /**
+         * \brief Construct a new recorder. The file is not opened until open is called.
+         * \param path Path of the log. If it exists, records are appended to it.
+         * \param max_bytes Maximum size of the file, including records that were already in it.
+         * \param sample_every Record one in every sample_every parses.
+         */
+        explicit recorder(std::filesystem::path path, uint64_t max_bytes = 64ull << 20, uint64_t sample_every = 1);
+
+        recorder(const recorder&) = delete;
+
+        recorder(recorder&&) = delete;
+
+        /**
+         * \brief Writes all buffered records.
+         */
+        ~recorder() noexcept;
+
+        recorder& operator=(const recorder&) = delete;
+
+        recorder& operator=(recorder&&) = delete;
+
+        /**
+         * \brief Open the file. An existing file must be a recording of a parser with the same arguments.
+         * \param error Error string that is set when return value is false.
+         * \return False if the file could not be opened or is not a recording.
+         */
+        bool open(std::string& error);
+
+        /**
+         * \brief Write all buffered records to the file.
+         * \param error Error string that is set when return value is false.
+         * \return False if writing failed. No further records are written.
+         */
+        bool flush(std::string& error);
+
+        /**
+         * \brief Get the number of parses that were recorded.
+         * \return Count.
+         */
+        [[nodiscard]] uint64_t get_recorded() const noexcept;
+
+        /**
+         * \brief Get the number of sampled parses that were dropped because the file was full, not open or could
+         * not be written.
+         * \return Count.
+         */
+        [[nodiscard]] uint64_t get_dropped() const noexcept;
+
+        [[nodiscard]] const std::filesystem::path& get_path() const noexcept;
+
+    private:
+        /**
+         * \brief Verify that the recorder is used with parsers that have the same arguments.
+         * \param arguments Arguments of the parser.
+         */
+        void attach(const std::vector<argument_ptr>& arguments);
+
+        /**
+         * \brief Record a parse.
+         * \param args Arguments that were parsed.
+         * \param arguments Arguments of the parser.
+         * \param errors Errors.
+         */
+        void record(const std::vector<std::string>&   args,
+                    const std::vector<argument_ptr>&  arguments,
+                    const std::vector<parse_error_t>& errors);
+
+        /**
+         * \brief Write the buffer to the file. Must be called with the mutex held.
+         */
+        bool write(std::string& error);
+
+        /**
+         * \brief Hash of the names of the arguments of a parser.
+         */
+        [[nodiscard]] static fingerprint layout_of(const std::vector<argument_ptr>& arguments);
+
+        /**
+         * \brief Outcome of the last parse of a parser, without its arguments.
+         */
+        [[nodiscard]] static recorded_parse outcome_of(const std::vector<argument_ptr>&  arguments,
+                                                       const std::vector<parse_error_t>& errors);
+
+        const std::filesystem::path path;
+        const uint64_t              max_bytes;
+        const uint64_t              sample_every;
+
+        std::atomic<uint64_t> sampled  = 0;
+        std::atomic<uint64_t> recorded = 0;
+        std::atomic<uint64_t> dropped  = 0;
+
+        /**
+         * \brief Set when the file is open and has room for more records. Checked before encoding a parse.
+         */
+        std::atomic<bool> accepting = false;
+
+        /**
+         * \brief Protects everything below.
+         */
+        std::mutex    mutex;
+        std::ofstream file;
+        std::string   buffer;
+        uint64_t      size = 0;
+        bool          has_layout = false;
+        fingerprint   layout;
+    };
+
+    /**
+     * \brief Read a recording.
+     * \param path Path of the log.
+     * \param log Recording. A truncated last record, e.g. after a crash, is ignored.
+     * \param error Error string that is set when return value is false.
+     * \return False if the file could not be read or is not a recording.
+     */
+    bool read_recording(const std::filesystem::path& path, recording& log, std::string& error);
+
+    /**
+     * \brief Parse all recorded arguments again, measure the time spent in the parser and compare the outcome of
+     * each parse to the recording. Throws an exception if the parser has different arguments than the recording
+     * parser or has a recorder.
+     * \param p Parser with the same arguments as the recording parser.
+     * \param log Recording.
+     * \param iterations Number of times the recording is replayed. Outcomes are compared in the first iteration.
+     * \return Report.
+     */
+    replay_report replay(parser& p, const recording& log, size_t iterations = 1);
+}  // namespace pt
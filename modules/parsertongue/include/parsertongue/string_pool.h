@@ -0,0 +1,177 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/converter.h"
+#include "parsertongue/parsable.h"
+
+namespace pt
+{
+    class string_pool;
+
+    /**
+     * \brief Handle to a string in a string_pool. Equal strings interned in the same pool share the same handle, so
+     * comparing handles is a pointer comparison. Handles from different pools never compare equal, not even those of the
+     * empty string.
+     */
+    class interned_string
+    {
+    public:
+        friend class string_pool;
+
+        /**
+         * \brief Construct an empty string that belongs to no pool. It does not compare equal to the empty string of
+         * any pool.
+         */
+        interned_string() noexcept;
+
+        [[nodiscard]] const std::string& str() const noexcept { return *s; }
+
+        [[nodiscard]] std::string_view view() const noexcept { return *s; }
+
+        operator std::string_view() const noexcept { return *s; }
+
+        [[nodiscard]] bool empty() const noexcept { return s->empty(); }
+
+        bool operator==(const interned_string& other) const noexcept { return s == other.s; }
+
+        [[nodiscard]] const std::string* data() const noexcept { return s; }
+
+    private:
+        explicit interned_string(const std::string* str) noexcept : s(str) {}
+
+        const std::string* s;
+    };
+
+    /**
+     * \brief Thread-safe pool of unique strings. Strings are never removed. Looking up strings that are already in
+     * the pool does not lock. Can be shared between parsers and across parses with parser::set_string_pool.
+     */
+    class string_pool
+    {
+    public:
+        string_pool();
+
+        string_pool(const string_pool&) = delete;
+
+        string_pool(string_pool&&) = delete;
+
+        ~string_pool() noexcept;
+
+        string_pool& operator=(const string_pool&) = delete;
+
+        string_pool& operator=(string_pool&&) = delete;
+
+        /**
+         * \brief Get the handle of a string, adding it to the pool if needed.
+         * \param str String.
+         * \return Handle.
+         */
+        [[nodiscard]] interned_string intern(std::string_view str);
+
+        /**
+         * \brief Get the handle of a string without adding it. Does not lock.
+         * \param str String.
+         * \param handle Set to the handle if the string was found.
+         * \return True if the string is in the pool.
+         */
+        [[nodiscard]] bool find(std::string_view str, interned_string& handle) const noexcept;
+
+        /**
+         * \brief Get the number of strings in the pool.
+         * \return Number of strings.
+         */
+        [[nodiscard]] size_t size() const noexcept;
+
+        /**
+         * \brief Get the process-wide pool that is used when no pool was set.
+         * \return Pool.
+         */
+        [[nodiscard]] static string_pool& global();
+
+    private:
+        struct entry
+        {
+            size_t      hash;
+            std::string str;
+        };
+
+        /**
+         * \brief Open addressing hash table of entries. Tables are replaced by larger ones when they fill up, but
+         * kept alive so that concurrent readers can finish with them.
+         */
+        struct table
+        {
+            explicit table(size_t capacity);
+
+            size_t                                       mask;
+            std::unique_ptr<std::atomic<const entry*>[]> slots;
+        };
+
+        [[nodiscard]] static const entry* lookup(const table& t, std::string_view str, size_t hash) noexcept;
+
+        static void insert(table& t, const entry* e) noexcept;
+
+        /**
+         * \brief The empty string of this pool. It is not stored in the tables, so it does not count towards size.
+         */
+        const std::string empty;
+
+        std::atomic<table*>                 current;
+        std::atomic<size_t>                 count = 0;
+        std::vector<std::unique_ptr<table>> tables;
+        std::vector<std::unique_ptr<entry>> entries;
+        std::mutex                          mutex;
+    };
+
+    template<>
+    struct converter<interned_string>
+    {
+        /**
+         * \brief Interns into the global pool. Values and lists use the pool of their parser instead.
+         */
+        static bool parse(const std::string_view arg, interned_string& value) noexcept
+        {
+            value = string_pool::global().intern(arg);
+            return true;
+        }
+    };
+
+    namespace detail
+    {
+        /**
+         * \brief Convert a string like parse_value, but intern strings into the given pool.
+         */
+        template<parsable T>
+        std::expected<T, conversion_error> parse_value(const std::string& arg, string_pool* pool)
+        {
+            if constexpr (std::is_same_v<T, interned_string>)
+                return (pool ? *pool : string_pool::global()).intern(arg);
+            else
+                return pt::parse_value<T>(arg);
+        }
+    }  // namespace detail
+}  // namespace pt
+
+template<>
+struct std::hash<pt::interned_string>
+{
+    size_t operator()(const pt::interned_string& s) const noexcept { return std::hash<const void*>{}(s.data()); }
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/argument.h"
+#include "parsertongue/parse_error.h"
+
+namespace pt
+{
+    class parser;
+
+    /**
+     * \brief Estimated number of times a value was passed. The true count is between count - error and count.
+     */
+    struct value_count
+    {
+        std::string value;
+        uint64_t    count = 0;
+        uint64_t    error = 0;
+    };
+
+    struct argument_usage
+    {
+        /**
+         * \brief Display name of the argument.
+         */
+        std::string name;
+
+        /**
+         * \brief Number of parses in which the argument was passed on the command line.
+         */
+        uint64_t command_line = 0;
+
+        /**
+         * \brief Number of parses in which the argument was read from the environment.
+         */
+        uint64_t environment = 0;
+
+        /**
+         * \brief Most frequently passed values, in descending order of count.
+         */
+        std::vector<value_count> top_values;
+    };
+
+    /**
+     * \brief Aggregated counts of a telemetry sink at one point in time.
+     */
+    struct telemetry_snapshot
+    {
+        uint64_t parses = 0;
+
+        std::vector<argument_usage> arguments;
+
+        /**
+         * \brief Number of occurrences of each kind of error that occurred at least once.
+         */
+        std::vector<std::pair<parse_error, uint64_t>> errors;
+
+        /**
+         * \brief Format as a JSON object.
+         * \return String.
+         */
+        [[nodiscard]] std::string to_json() const;
+    };
+
+    /**
+     * \brief Opt-in sink that aggregates how arguments are used across many parses and threads: how often each
+     * argument is passed, how often each kind of error occurs, and the most common values per argument. Each thread
+     * records into its own shard, so recording does not contend with other threads. Share a sink only between
+     * parsers that have the same arguments, added in the same order.
+     */
+    class telemetry
+    {
+    public:
+        friend class parser;
+
+        /**
+         * \brief Construct a new sink.
+         * \param top_k Number of values that are tracked per argument and thread.
+         * \param max_value_length Values are truncated to this length before they are counted.
+         */
+        explicit telemetry(size_t top_k = 16, size_t max_value_length = 64);
+
+        telemetry(const telemetry&) = delete;
+
+        telemetry(telemetry&&) = delete;
+
+        ~telemetry() noexcept;
+
+        telemetry& operator=(const telemetry&) = delete;
+
+        telemetry& operator=(telemetry&&) = delete;
+
+        /**
+         * \brief Merge the shards of all threads. Can be called while other threads are recording.
+         * \return Snapshot.
+         */
+        [[nodiscard]] telemetry_snapshot snapshot() const;
+
+    private:
+        struct shard;
+
+        /**
+         * \brief Record the outcome of a parse.
+         * \param arguments Arguments of the parser.
+         * \param errors Errors.
+         * \param observations Index of an argument and a string that was passed to it.
+         */
+        void record(const std::vector<argument_ptr>&                    arguments,
+                    const std::vector<parse_error_t>&                   errors,
+                    const std::vector<std::pair<size_t, std::string>>& observations);
+
+        /**
+         * \brief Get the shard of the calling thread, creating it on first use.
+         */
+        shard& local(const std::vector<argument_ptr>& arguments);
+
+        /**
+         * \brief Unique identifier, so that threads can cache their shard without keeping the sink alive.
+         */
+        const uint64_t id;
+
+        const size_t top_k;
+
+        const size_t max_value_length;
+
+        std::vector<std::string>            names;
+        std::vector<std::unique_ptr<shard>> shards;
+        mutable std::mutex                  mutex;
+    };
+}  // namespace pt
@@ -0,0 +1,52 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace pt
+{
+    /**
+     * \brief Value that did not pass validation.
+     */
+    struct validation_failure
+    {
+        /**
+         * \brief Index of the value in the batch.
+         */
+        size_t index = 0;
+
+        std::string message;
+    };
+
+    /**
+     * \brief Validates all values of an argument at once, after parsing. Appends a failure for each invalid value.
+     * Receiving the whole batch lets validators check values concurrently.
+     * \tparam T Type.
+     */
+    template<typename T>
+    using validator = std::function<void(std::span<const T> values, std::vector<validation_failure>& failures)>;
+
+    /**
+     * \brief Create a validator that checks values one by one.
+     * \tparam T Type.
+     * \tparam F Predicate type.
+     * \param predicate Returns true for valid values.
+     * \param message Message for invalid values.
+     * \return Validator.
+     */
+    template<typename T, typename F>
+    validator<T> validate_each(F predicate, std::string message)
+    {
+        return [predicate = std::move(predicate), message = std::move(message)](
+                 std::span<const T> values, std::vector<validation_failure>& failures) {
+            for (size_t i = 0; i < values.size(); i++)
+                if (!predicate(values[i])) failures.push_back({.index = i, .message = message});
+        };
+    }
+}  // namespace pt
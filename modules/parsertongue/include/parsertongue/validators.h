@@ -0,0 +1,67 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/validator.h"
+
+namespace pt
+{
+    /**
+     * \brief What path_validator checks for each path.
+     */
+    struct path_requirements
+    {
+        bool exists       = true;
+        bool regular_file = false;
+        bool directory    = false;
+        bool readable     = false;
+        bool writable     = false;
+    };
+
+    /**
+     * \brief Validator that checks many paths concurrently. The checks are spread over a pool of threads that is
+     * shared by all path validators and started on first use, and the calling thread takes part in them. Validation
+     * is synchronous: it returns once all paths were checked. Can be added to values and lists of std::string or
+     * std::filesystem::path.
+     */
+    class path_validator
+    {
+    public:
+        /**
+         * \brief Construct a new path validator.
+         * \param requirements Checks to perform.
+         * \param threads Maximum number of threads that check the paths of one list, including the calling thread. 0
+         * uses all threads of the pool.
+         */
+        explicit path_validator(path_requirements requirements = {}, size_t threads = 0);
+
+        void operator()(std::span<const std::string> paths, std::vector<validation_failure>& failures) const;
+
+        void operator()(std::span<const std::filesystem::path> paths, std::vector<validation_failure>& failures) const;
+
+    private:
+        /**
+         * \brief Check a single path.
+         * \param path Path.
+         * \return Error message, or an empty string if the path is valid.
+         */
+        [[nodiscard]] std::string check(const std::filesystem::path& path) const;
+
+        template<typename T>
+        void run(std::span<const T> paths, std::vector<validation_failure>& failures) const;
+
+        path_requirements requirements;
+        size_t            threads;
+    };
+}  // namespace pt
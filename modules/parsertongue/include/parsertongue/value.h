@@ -4,8 +4,14 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <expected>
 #include <format>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
@@ -17,15 +23,22 @@
 #include "parsertongue/parsable.h"
 #include "parsertongue/parser_tongue_exception.h"
 #include "parsertongue/parse_error.h"
+#include "parsertongue/string_pool.h"
+#include "parsertongue/validator.h"
 
 namespace pt
 {
     class parser;
 
+    template<parsable T>
+    class value;
+
     class base_value : public argument
     {
     public:
         friend class parser;
+        template<parsable T>
+        friend class value;
 
         base_value() = delete;
 
@@ -46,11 +59,58 @@ namespace pt
     protected:
         bool valid = false;
 
+        /**
+         * \brief Pool for interned strings. Set by the parser.
+         */
+        string_pool* pool = nullptr;
+
         virtual void parse(const std::string& arg, std::vector<parse_error_t>& parse_errors) noexcept = 0;
+
+        void parse_env(const std::string& arg, std::vector<parse_error_t>& parse_errors) override
+        {
+            parse(arg, parse_errors);
+        }
+
+    private:
+        /**
+         * \brief Check if the derived default of this value depends on another value, directly or indirectly.
+         * \param other Value.
+         * \return True if other is reachable through the dependencies.
+         */
+        [[nodiscard]] bool depends_on(const base_value& other) const
+        {
+            std::vector<const base_value*> pending(dependencies.begin(), dependencies.end());
+            std::vector<const base_value*> visited;
+            while (!pending.empty())
+            {
+                const auto* d = pending.back();
+                pending.pop_back();
+                if (d == &other) return true;
+                if (std::ranges::find(visited, d) != visited.end()) continue;
+                visited.push_back(d);
+                pending.insert(pending.end(), d->dependencies.begin(), d->dependencies.end());
+            }
+            return false;
+        }
+
+        /**
+         * \brief Values from which the derived default is computed. Kept alive by the function that computes it.
+         */
+        std::vector<const base_value*> dependencies;
     };
 
     using value_ptr = std::shared_ptr<base_value>;
 
+    template<parsable T>
+    class value_state final : public argument_state
+    {
+    public:
+        value_state(std::optional<T> v, const fingerprint digest) : v(std::move(v)), digest(digest) {}
+
+        const std::optional<T> v;
+        const fingerprint      digest;
+    };
+
     template<parsable T>
     class value final : public base_value
     {
@@ -75,8 +135,8 @@ namespace pt
          */
         [[nodiscard]] bool is_set() const
         {
-            if (!valid) throw parser_tongue_exception("Cannot retrieve value before running the parser");
-            return v || default_value;
+            if (!valid) throw_exception("Cannot retrieve value before running the parser");
+            return v || default_value || (derived && derived->derivable());
         }
 
         /**
@@ -85,20 +145,63 @@ namespace pt
          */
         [[nodiscard]] const T& get_value() const
         {
-            if (!valid) throw parser_tongue_exception("Cannot retrieve value before running the parser");
-            if (!v)
+            if (!valid) throw_exception("Cannot retrieve value before running the parser");
+            if (v) return *v;
+            if (default_value) return *default_value;
+            if (!derived) throw_exception(std::format("{0} was not set", get_pretty_name()));
+
+            // The result can be read concurrently, so the first reader computes it under the lock.
+            if (!derived->computed.load(std::memory_order_acquire))
             {
-                if (!default_value) throw parser_tongue_exception(std::format("{0} was not set", get_pretty_name()));
-                return *default_value;
+                std::scoped_lock lock(derived->mutex);
+                if (!derived->computed.load(std::memory_order_relaxed))
+                {
+                    if (!derived->derivable()) throw_exception(std::format("{0} was not set", get_pretty_name()));
+                    derived->result = derived->derive();
+                    derived->computed.store(true, std::memory_order_release);
+                }
             }
-            return *v;
+            return *derived->result;
         }
 
         /**
          * \brief Set a default value that is returned by get_value when the user did not pass any value.
          * \param value Default value.
          */
-        void set_default(const T& value) noexcept { default_value = value; }
+        void set_default(const T& value) noexcept
+        {
+            default_value = value;
+            derived.reset();
+            dependencies.clear();
+        }
+
+        /**
+         * \brief Set a default that is computed from the values of other arguments. It is only computed by the first
+         * call to get_value that needs it, also when called from multiple threads, and memoised until the parser is
+         * run again. Throws an exception if the default would depend on this value itself, directly or through the
+         * defaults of its dependencies. Running the parser throws an exception if a dependency was added to another
+         * parser.
+         * \tparam F Function that receives the values of the dependencies, in order.
+         * \tparam Ds Value types of the dependencies.
+         * \param f Function.
+         * \param deps Values of the same parser. If any of them is not set, this value is not set either.
+         */
+        template<typename F, parsable... Ds>
+            requires(sizeof...(Ds) > 0 && std::convertible_to<std::invoke_result_t<F&, const Ds&...>, T>)
+        void set_default(F f, std::shared_ptr<value<Ds>>... deps)
+        {
+            if ((!deps || ...)) throw_exception("Dependencies should not be null");
+            if (((static_cast<const base_value*>(deps.get()) == this || deps->depends_on(*this)) || ...))
+                throw_exception(std::format("The default of {0} cannot depend on itself", get_pretty_name()));
+
+            default_value.reset();
+            dependencies       = {deps.get()...};
+            derived            = std::make_unique<derived_default>();
+            derived->derivable = [deps...] { return (deps->is_set() && ...); };
+            derived->derive    = [f = std::move(f), deps...]() mutable {
+                return static_cast<T>(std::invoke(f, deps->get_value()...));
+            };
+        }
 
         /**
          * \brief Limit the number of allowed values to all options that are added through this method.
@@ -117,39 +220,123 @@ namespace pt
             (add_option(std::move(values)), ...);
         }
 
+        /**
+         * \brief Add a validator that is run on the value after parsing. Failures are reported as validation_failed
+         * errors, but the value remains set.
+         * \param v Validator.
+         */
+        void add_validator(validator<T> v) { validators.emplace_back(std::move(v)); }
+
         void reset() override
         {
             base_value::reset();
             v.reset();
+            if (derived) derived->clear();
+            digest = {};
         }
 
     protected:
-        void parse(const std::string& arg, std::vector<parse_error_t>& parse_errors) noexcept override
+        [[nodiscard]] argument_state_ptr save() const override
         {
-            try
-            {
-                T val;
-                parse_value(arg, val);
+            return std::make_shared<value_state<T>>(v, digest);
+        }
 
-                // If there is a limited number of allowed options, check if the passed value is valid.
-                if (!options.empty())
-                {
-                    if (std::find(options.cbegin(), options.cend(), val) == options.end())
-                        throw parser_tongue_exception(
-                          std::format("{0} is not a valid option for {1}", arg, get_pretty_name()));
-                }
+        void restore(const argument_state& state) override
+        {
+            const auto& s = static_cast<const value_state<T>&>(state);
+            v             = s.v;
+            digest        = s.digest;
+            if (derived) derived->clear();
+        }
+
+        [[nodiscard]] bool has_value() const noexcept override { return v.has_value(); }
 
-                v = val;
+        [[nodiscard]] fingerprint get_fingerprint() const noexcept override { return digest; }
+
+        void validate(std::vector<parse_error_t>& parse_errors) const override
+        {
+            if (!v) return;
+
+            std::vector<validation_failure> failures;
+            for (const auto& validator : validators) validator(std::span<const T>(&*v, 1), failures);
+            for (auto& f : failures)
+            {
+                std::string str;
+                if constexpr (std::is_convertible_v<const T&, std::string>)
+                    str = *v;
+                else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+                    str = std::string_view(*v);
+                parse_errors.emplace_back(parse_error::validation_failed,
+                                          std::move(str),
+                                          std::format("{0}: {1}", get_pretty_name(), f.message));
             }
-            catch (std::exception& e)
+        }
+
+        void parse(const std::string& arg, std::vector<parse_error_t>& parse_errors) noexcept override
+        {
+            auto val = detail::parse_value<T>(arg, pool);
+
+            // If there is a limited number of allowed options, check if the passed value is valid.
+            if (val && !options.empty() && std::find(options.cbegin(), options.cend(), *val) == options.end())
+                val = std::unexpected(conversion_error::invalid_option);
+
+            if (val)
             {
-                parse_errors.emplace_back(parse_error::parsing_error, arg, e.what());
+                digest = detail::hash_value(*val, arg);
+                v      = std::move(*val);
             }
+            else
+                parse_errors.emplace_back(parse_error::parsing_error, arg, get_conversion_message(val.error(), arg));
         }
 
     private:
-        std::optional<T> v;
-        std::optional<T> default_value;
-        std::vector<T>   options;
+        std::optional<T>          v;
+        std::optional<T>          default_value;
+        std::vector<T>            options;
+        std::vector<validator<T>> validators;
+        fingerprint               digest;
+
+        /**
+         * \brief Default that is computed from other values.
+         */
+        struct derived_default
+        {
+            /**
+             * \brief Forget the result. Must not be called while the value is read.
+             */
+            void clear() noexcept
+            {
+                result.reset();
+                computed.store(false, std::memory_order_relaxed);
+            }
+
+            std::function<T()>    derive;
+            std::function<bool()> derivable;
+
+            /**
+             * \brief Set once result is computed. Protects result together with the mutex.
+             */
+            std::atomic<bool> computed = false;
+            std::mutex        mutex;
+            std::optional<T>  result;
+        };
+
+        std::unique_ptr<derived_default> derived;
     };
-}  // namespace pt
\ No newline at end of file
+
+    // Instantiated in the library for common types.
+    extern template class value_state<int>;
+    extern template class value<int>;
+    extern template class value_state<int64_t>;
+    extern template class value<int64_t>;
+    extern template class value_state<uint64_t>;
+    extern template class value<uint64_t>;
+    extern template class value_state<double>;
+    extern template class value<double>;
+    extern template class value_state<float>;
+    extern template class value<float>;
+    extern template class value_state<bool>;
+    extern template class value<bool>;
+    extern template class value_state<std::string>;
+    extern template class value<std::string>;
+}  // namespace pt
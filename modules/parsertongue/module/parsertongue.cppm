@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////
+// Module interface. Exports the public API of the headers, so
+// that they are parsed once when building the module instead
+// of in every translation unit that uses the library.
+////////////////////////////////////////////////////////////////
+
+module;
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/argument.h"
+#include "parsertongue/binding.h"
+#include "parsertongue/bytes.h"
+#include "parsertongue/columnar.h"
+#include "parsertongue/constraints.h"
+#include "parsertongue/converter.h"
+#include "parsertongue/converters.h"
+#include "parsertongue/fingerprint.h"
+#include "parsertongue/flag.h"
+#include "parsertongue/list.h"
+#include "parsertongue/list_storage.h"
+#include "parsertongue/list_view.h"
+#include "parsertongue/map.h"
+#include "parsertongue/option_file.h"
+#include "parsertongue/parsable.h"
+#include "parsertongue/parser.h"
+#include "parsertongue/parser_tongue_exception.h"
+#include "parsertongue/parse_cache.h"
+#include "parsertongue/parse_checkpoint.h"
+#include "parsertongue/parse_error.h"
+#include "parsertongue/parse_limits.h"
+#include "parsertongue/parse_result.h"
+#include "parsertongue/push_parser.h"
+#include "parsertongue/recorder.h"
+#include "parsertongue/string_pool.h"
+#include "parsertongue/telemetry.h"
+#include "parsertongue/validator.h"
+#include "parsertongue/validators.h"
+#include "parsertongue/value.h"
+
+export module parsertongue;
+
+export namespace pt
+{
+    using pt::appendable;
+    using pt::argument;
+    using pt::argument_ptr;
+    using pt::argument_state;
+    using pt::argument_state_ptr;
+    using pt::argument_usage;
+    using pt::base_list;
+    using pt::base_value;
+    using pt::binary_encoding;
+    using pt::bound_list;
+    using pt::bound_value;
+    using pt::byte_size;
+    using pt::bytes_ptr;
+    using pt::bytes_value;
+    using pt::chunked_storage;
+    using pt::column;
+    using pt::column_batch;
+    using pt::columnar;
+    using pt::conversion_error;
+    using pt::converter;
+    using pt::decode;
+    using pt::decoded_size;
+    using pt::duplicate_policy;
+    using pt::fingerprint;
+    using pt::fingerprint_hasher;
+    using pt::fingerprintable;
+    using pt::flag;
+    using pt::flag_column;
+    using pt::flag_ptr;
+    using pt::flat_map;
+    using pt::flat_map_key;
+    using pt::has_converter;
+    using pt::inline_storage;
+    using pt::interned_string;
+    using pt::ip_address;
+    using pt::ip_endpoint;
+    using pt::list;
+    using pt::list_column;
+    using pt::list_ptr;
+    using pt::list_segment;
+    using pt::list_storage;
+    using pt::list_view;
+    using pt::map;
+    using pt::operand_column;
+    using pt::operator<<;
+    using pt::option_file;
+    using pt::option_snapshot;
+    using pt::option_snapshot_ptr;
+    using pt::parsable;
+    using pt::parse_cache;
+    using pt::parse_checkpoint;
+    using pt::parse_checkpoint_ptr;
+    using pt::parse_error;
+    using pt::parse_error_t;
+    using pt::parse_limits;
+    using pt::parse_result;
+    using pt::parse_result_ptr;
+    using pt::parse_value;
+    using pt::path_requirements;
+    using pt::path_validator;
+    using pt::parser;
+    using pt::parser_tongue_exception;
+    using pt::push_parser;
+    using pt::range_parsable;
+    using pt::read_recording;
+    using pt::recorded_parse;
+    using pt::recorder;
+    using pt::recording;
+    using pt::replay;
+    using pt::replay_report;
+    using pt::reserved_storage;
+    using pt::set_storage;
+    using pt::small_vector;
+    using pt::storage_policy;
+    using pt::string_pool;
+    using pt::telemetry;
+    using pt::telemetry_snapshot;
+    using pt::validate_each;
+    using pt::validation_failure;
+    using pt::validator;
+    using pt::value;
+    using pt::value_column;
+    using pt::value_count;
+    using pt::value_ptr;
+    using pt::value_source;
+    using pt::vector_storage;
+}  // namespace pt
+
+// Structs of the Arrow C data interface, used by column_batch::export_arrow.
+export
+{
+    using ::ArrowArray;
+    using ::ArrowSchema;
+}
@@ -24,9 +24,34 @@ namespace pt
         relevant_arguments.emplace_back(&arg, required);
     }
 
+    void argument::set_env(std::string name) { env_name = std::move(name); }
+
+    value_source argument::get_source() const noexcept { return source; }
+
+    void argument::set_fingerprint(const bool enabled) { fingerprinted = enabled; }
+
+    void argument::validate(std::vector<parse_error_t>&) const {}
+
     std::string argument::get_pretty_name() const
     {
+        if (positional) return std::format("<{0}>", long_name);
         return std::format("[{0}, {1}]", short_name == '\0' ? '_' : short_name, long_name.empty() ? "_" : long_name);
     }
 
+    std::string argument::get_conversion_message(const conversion_error error, const std::string& str) const
+    {
+        switch (error)
+        {
+        case conversion_error::invalid_value:
+            return std::format("{0} is not a valid value for {1}", str, get_pretty_name());
+        case conversion_error::invalid_option:
+            return std::format("{0} is not a valid option for {1}", str, get_pretty_name());
+        case conversion_error::invalid_range:
+            return std::format("{0} is not a valid range for {1}", str, get_pretty_name());
+        case conversion_error::invalid_pair:
+            return std::format("{0} is not a valid key-value pair for {1}", str, get_pretty_name());
+        }
+        return {};
+    }
+
 }  // namespace pt
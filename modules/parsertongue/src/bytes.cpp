@@ -0,0 +1,349 @@
+#include "parsertongue/bytes.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <format>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARSERTONGUE_SSE2 1
+#else
+#define PARSERTONGUE_SSE2 0
+#endif
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/parser_tongue_exception.h"
+
+using namespace std::string_literals;
+
+namespace pt
+{
+    namespace
+    {
+        constexpr auto npos = std::string_view::npos;
+
+        constexpr std::array<int8_t, 256> hex_table = [] {
+            std::array<int8_t, 256> t{};
+            t.fill(-1);
+            for (int i = 0; i < 10; i++) t['0' + i] = static_cast<int8_t>(i);
+            for (int i = 0; i < 6; i++)
+            {
+                t['a' + i] = static_cast<int8_t>(10 + i);
+                t['A' + i] = static_cast<int8_t>(10 + i);
+            }
+            return t;
+        }();
+
+        constexpr std::array<int8_t, 256> base64_table = [] {
+            std::array<int8_t, 256> t{};
+            t.fill(-1);
+            for (int i = 0; i < 26; i++)
+            {
+                t['A' + i] = static_cast<int8_t>(i);
+                t['a' + i] = static_cast<int8_t>(26 + i);
+            }
+            for (int i = 0; i < 10; i++) t['0' + i] = static_cast<int8_t>(52 + i);
+            t['+'] = 62;
+            t['/'] = 63;
+            return t;
+        }();
+
+        int8_t lookup(const std::array<int8_t, 256>& table, const char c) noexcept
+        {
+            return table[static_cast<unsigned char>(c)];
+        }
+
+        /**
+         * \brief Length of base64 text without padding.
+         */
+        size_t base64_length(const std::string_view text) noexcept
+        {
+            auto n = text.size();
+            for (size_t pad = 0; pad < 2 && n > 0 && text[n - 1] == '='; pad++) n--;
+            return n;
+        }
+
+#if PARSERTONGUE_SSE2
+        /**
+         * \brief Convert 16 hexadecimal digits to their values.
+         * \param c Characters.
+         * \param valid Set to a mask of the valid characters.
+         * \return Values.
+         */
+        __m128i hex_nibbles(const __m128i c, int& valid) noexcept
+        {
+            const auto zero = _mm_setzero_si128();
+
+            // Unsigned range checks: x <= n if saturating x - n is 0.
+            const auto d    = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+            const auto is_d = _mm_cmpeq_epi8(_mm_subs_epu8(d, _mm_set1_epi8(9)), zero);
+            const auto l    = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+            const auto is_l = _mm_cmpeq_epi8(_mm_subs_epu8(l, _mm_set1_epi8(5)), zero);
+            valid = _mm_movemask_epi8(_mm_or_si128(is_d, is_l));
+            return _mm_or_si128(_mm_and_si128(is_d, d), _mm_and_si128(is_l, _mm_add_epi8(l, _mm_set1_epi8(10))));
+        }
+
+        /**
+         * \brief Combine pairs of nibbles into bytes, stored in the low byte of each 16-bit lane.
+         */
+        __m128i hex_pairs(const __m128i nibbles) noexcept
+        {
+            const auto high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00ff)), 4);
+            const auto low  = _mm_srli_epi16(nibbles, 8);
+            return _mm_or_si128(high, low);
+        }
+
+        /**
+         * \brief Decode blocks of 32 digits.
+         * \return Number of characters that were decoded.
+         */
+        size_t decode_hex_sse2(const std::string_view text, uint8_t* out) noexcept
+        {
+            size_t i = 0;
+            for (; i + 32 <= text.size(); i += 32)
+            {
+                int        valid0 = 0, valid1 = 0;
+                const auto a = hex_nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i)), valid0);
+                const auto b =
+                  hex_nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i + 16)), valid1);
+
+                // Leave blocks with invalid characters to the scalar decoder, which finds the offset.
+                if ((valid0 & valid1) != 0xffff) break;
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), _mm_packus_epi16(hex_pairs(a), hex_pairs(b)));
+            }
+            return i;
+        }
+
+        /**
+         * \brief Decode blocks of 16 characters into 12 bytes.
+         * \return Number of characters that were decoded.
+         */
+        size_t decode_base64_sse2(const std::string_view text, uint8_t* out) noexcept
+        {
+            const auto zero = _mm_setzero_si128();
+
+            size_t i = 0;
+            for (; i + 16 <= text.size(); i += 16)
+            {
+                const auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+
+                const auto upper    = _mm_sub_epi8(c, _mm_set1_epi8('A'));
+                const auto is_upper = _mm_cmpeq_epi8(_mm_subs_epu8(upper, _mm_set1_epi8(25)), zero);
+                const auto lower    = _mm_sub_epi8(c, _mm_set1_epi8('a'));
+                const auto is_lower = _mm_cmpeq_epi8(_mm_subs_epu8(lower, _mm_set1_epi8(25)), zero);
+                const auto digit    = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+                const auto is_digit = _mm_cmpeq_epi8(_mm_subs_epu8(digit, _mm_set1_epi8(9)), zero);
+                const auto is_plus  = _mm_cmpeq_epi8(c, _mm_set1_epi8('+'));
+                const auto is_slash = _mm_cmpeq_epi8(c, _mm_set1_epi8('/'));
+
+                const auto valid = _mm_or_si128(_mm_or_si128(is_upper, is_lower),
+                                                _mm_or_si128(is_digit, _mm_or_si128(is_plus, is_slash)));
+                if (_mm_movemask_epi8(valid) != 0xffff) break;
+
+                auto v = _mm_and_si128(is_upper, upper);
+                v      = _mm_or_si128(v, _mm_and_si128(is_lower, _mm_add_epi8(lower, _mm_set1_epi8(26))));
+                v      = _mm_or_si128(v, _mm_and_si128(is_digit, _mm_add_epi8(digit, _mm_set1_epi8(52))));
+                v      = _mm_or_si128(v, _mm_and_si128(is_plus, _mm_set1_epi8(62)));
+                v      = _mm_or_si128(v, _mm_and_si128(is_slash, _mm_set1_epi8(63)));
+
+                // Each 32-bit lane holds sextets a b c d in its bytes. Merge them into a 24-bit value a b c d.
+                const auto mask  = _mm_set1_epi32(0x00ff00ff);
+                const auto pairs = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(v, mask), 6),
+                                                _mm_and_si128(_mm_srli_epi32(v, 8), mask));
+                const auto merged = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(pairs, _mm_set1_epi32(0xffff)), 12),
+                                                 _mm_srli_epi32(pairs, 16));
+
+                alignas(16) uint32_t lanes[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), merged);
+                auto* o = out + i / 4 * 3;
+                for (const auto lane : lanes)
+                {
+                    *o++ = static_cast<uint8_t>(lane >> 16);
+                    *o++ = static_cast<uint8_t>(lane >> 8);
+                    *o++ = static_cast<uint8_t>(lane);
+                }
+            }
+            return i;
+        }
+#endif
+    }  // namespace
+
+    size_t decoded_size(const binary_encoding encoding, const std::string_view text) noexcept
+    {
+        if (encoding == binary_encoding::hex) return text.size() / 2;
+
+        const auto n = base64_length(text);
+        return n / 4 * 3 + (n % 4 == 3 ? 2 : n % 4 == 2 ? 1 : 0);
+    }
+
+    size_t decode(const binary_encoding encoding, const std::string_view text, uint8_t* out) noexcept
+    {
+        size_t done = 0;
+        if (encoding == binary_encoding::hex)
+        {
+#if PARSERTONGUE_SSE2
+            done = decode_hex_sse2(text, out);
+#endif
+            const auto offset = detail::decode_hex_scalar(text.substr(done), out + done / 2);
+            return offset == npos ? npos : offset + done;
+        }
+
+#if PARSERTONGUE_SSE2
+        done = decode_base64_sse2(text.substr(0, base64_length(text)), out);
+#endif
+        const auto offset = detail::decode_base64_scalar(text.substr(done), out + done / 4 * 3);
+        return offset == npos ? npos : offset + done;
+    }
+
+    std::expected<std::vector<uint8_t>, size_t> decode(const binary_encoding encoding, const std::string_view text)
+    {
+        std::vector<uint8_t> bytes(decoded_size(encoding, text));
+        if (const auto offset = decode(encoding, text, bytes.data()); offset != npos) return std::unexpected(offset);
+        return bytes;
+    }
+
+    namespace detail
+    {
+        size_t decode_hex_scalar(const std::string_view text, uint8_t* out) noexcept
+        {
+            for (size_t i = 0; i + 1 < text.size(); i += 2)
+            {
+                const auto high = lookup(hex_table, text[i]);
+                if (high < 0) return i;
+                const auto low = lookup(hex_table, text[i + 1]);
+                if (low < 0) return i + 1;
+                *out++ = static_cast<uint8_t>(high << 4 | low);
+            }
+
+            // An odd number of digits is missing its last digit.
+            if (text.size() % 2 == 1) return lookup(hex_table, text.back()) < 0 ? text.size() - 1 : text.size();
+            return npos;
+        }
+
+        size_t decode_base64_scalar(const std::string_view text, uint8_t* out) noexcept
+        {
+            const auto n = base64_length(text);
+
+            // Padding is only allowed to complete the last group.
+            if (n != text.size() && text.size() % 4 != 0) return n;
+
+            uint32_t bits  = 0;
+            size_t   count = 0;
+            for (size_t i = 0; i < n; i++)
+            {
+                const auto v = lookup(base64_table, text[i]);
+                if (v < 0) return i;
+                bits = bits << 6 | static_cast<uint32_t>(v);
+                if (++count == 4)
+                {
+                    *out++ = static_cast<uint8_t>(bits >> 16);
+                    *out++ = static_cast<uint8_t>(bits >> 8);
+                    *out++ = static_cast<uint8_t>(bits);
+                    bits   = 0;
+                    count  = 0;
+                }
+            }
+
+            // A single character cannot encode a whole byte.
+            if (count == 1) return n;
+            if (count == 2) *out = static_cast<uint8_t>(bits >> 4);
+            if (count == 3)
+            {
+                *out++ = static_cast<uint8_t>(bits >> 10);
+                *out   = static_cast<uint8_t>(bits >> 2);
+            }
+            return npos;
+        }
+    }  // namespace detail
+
+    bytes_value::bytes_value(const char short_name, std::string long_name, const binary_encoding encoding) :
+        base_value(short_name, std::move(long_name)), encoding(encoding)
+    {
+    }
+
+    bool bytes_value::is_set() const
+    {
+        if (!valid) throw_exception("Cannot retrieve value before running the parser"s);
+        return data != nullptr;
+    }
+
+    std::span<const uint8_t> bytes_value::get_value() const
+    {
+        if (!is_set()) throw_exception(std::format("{0} was not set", get_pretty_name()));
+        return {data.get(), size};
+    }
+
+    binary_encoding bytes_value::get_encoding() const noexcept { return encoding; }
+
+    void bytes_value::reset()
+    {
+        base_value::reset();
+        data.reset();
+        size   = 0;
+        digest = {};
+    }
+
+    argument_state_ptr bytes_value::save() const { return std::make_shared<bytes_state>(data, size, digest); }
+
+    void bytes_value::restore(const argument_state& state)
+    {
+        const auto& s = static_cast<const bytes_state&>(state);
+        data          = s.data;
+        size          = s.size;
+        digest        = s.digest;
+    }
+
+    bool bytes_value::has_value() const noexcept { return data != nullptr; }
+
+    fingerprint bytes_value::get_fingerprint() const noexcept { return digest; }
+
+    void bytes_value::parse(const std::string& arg, std::vector<parse_error_t>& parse_errors) noexcept
+    {
+        // Encoded payloads can be large, so only include the start in errors.
+        constexpr size_t max_length = 64;
+        const auto shorten = [&arg] { return arg.size() > max_length ? arg.substr(0, max_length) + "..."s : arg; };
+
+        // Decode directly into a buffer of the final size.
+        const auto                 n = decoded_size(encoding, arg);
+        std::shared_ptr<uint8_t[]> buffer;
+        if (!detail::try_allocate([&] { buffer = std::make_shared_for_overwrite<uint8_t[]>(n); }))
+        {
+            parse_errors.emplace_back(
+              parse_error::argument_too_long,
+              shorten(),
+              std::format("{0}: cannot allocate {1} bytes for the decoded value", get_pretty_name(), n));
+            return;
+        }
+        const auto offset = decode(encoding, arg, buffer.get());
+
+        if (offset != npos)
+        {
+            auto       str  = shorten();
+            const auto name = encoding == binary_encoding::hex ? "hex"s : "base64"s;
+            if (offset == arg.size())
+                parse_errors.emplace_back(
+                  parse_error::parsing_error,
+                  std::move(str),
+                  std::format("{0}: incomplete {1} at offset {2}", get_pretty_name(), name, offset));
+            else
+                parse_errors.emplace_back(
+                  parse_error::parsing_error,
+                  std::move(str),
+                  std::format("{0}: invalid {1} character at offset {2}", get_pretty_name(), name, offset));
+            return;
+        }
+
+        fingerprint_hasher hasher;
+        hasher.add(std::string_view(reinterpret_cast<const char*>(buffer.get()), n));
+        digest = hasher.digest();
+        data   = std::move(buffer);
+        size   = n;
+    }
+}  // namespace pt
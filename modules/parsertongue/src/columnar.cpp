@@ -0,0 +1,300 @@
+#include "parsertongue/columnar.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <limits>
+
+namespace pt
+{
+    using namespace std::string_literals;
+
+    namespace
+    {
+        alignas(64) constexpr uint8_t empty[64] = {};
+
+        /**
+         * \brief Private data of an exported schema. Owns the strings and children it points to.
+         */
+        struct schema_data
+        {
+            schema_data() = default;
+
+            schema_data(const schema_data&) = delete;
+
+            schema_data(schema_data&&) = delete;
+
+            ~schema_data() noexcept
+            {
+                for (auto* child : children) release_child(child);
+                if (dictionary) release_child(dictionary);
+            }
+
+            schema_data& operator=(const schema_data&) = delete;
+
+            schema_data& operator=(schema_data&&) = delete;
+
+            /**
+             * \brief Release a child, unless the consumer moved it, and free its memory.
+             */
+            static void release_child(ArrowSchema* child) noexcept
+            {
+                if (child->release) child->release(child);
+                delete child;
+            }
+
+            std::string               format;
+            std::string               name;
+            std::vector<ArrowSchema*> children;
+            ArrowSchema*              dictionary = nullptr;
+        };
+
+        /**
+         * \brief Private data of an exported array. Owns the node with the buffers and the children.
+         */
+        struct array_data
+        {
+            array_data() = default;
+
+            array_data(const array_data&) = delete;
+
+            array_data(array_data&&) = delete;
+
+            ~array_data() noexcept
+            {
+                for (auto* child : children) release_child(child);
+                if (dictionary) release_child(dictionary);
+            }
+
+            array_data& operator=(const array_data&) = delete;
+
+            array_data& operator=(array_data&&) = delete;
+
+            static void release_child(ArrowArray* child) noexcept
+            {
+                if (child->release) child->release(child);
+                delete child;
+            }
+
+            std::unique_ptr<detail::arrow_node> node;
+            std::vector<ArrowArray*>            children;
+            ArrowArray*                         dictionary = nullptr;
+        };
+
+        void release_schema(ArrowSchema* schema) noexcept
+        {
+            delete static_cast<schema_data*>(schema->private_data);
+            schema->release = nullptr;
+        }
+
+        void release_array(ArrowArray* array) noexcept
+        {
+            delete static_cast<array_data*>(array->private_data);
+            array->release = nullptr;
+        }
+
+        void fill_schema(const detail::arrow_node& node, ArrowSchema* schema)
+        {
+            auto data    = std::make_unique<schema_data>();
+            data->format = node.format;
+            data->name   = node.name;
+
+            // Reserve first, so that a child is never lost between its allocation and being stored.
+            data->children.reserve(node.children.size());
+            for (const auto& child : node.children)
+            {
+                auto c = std::make_unique<ArrowSchema>();
+                fill_schema(*child, c.get());
+                data->children.push_back(c.release());
+            }
+            if (node.dictionary)
+            {
+                auto d = std::make_unique<ArrowSchema>();
+                fill_schema(*node.dictionary, d.get());
+                data->dictionary = d.release();
+            }
+
+            schema->format       = data->format.c_str();
+            schema->name         = data->name.c_str();
+            schema->metadata     = nullptr;
+            schema->flags        = node.flags;
+            schema->n_children   = static_cast<int64_t>(data->children.size());
+            schema->children     = data->children.empty() ? nullptr : data->children.data();
+            schema->dictionary   = data->dictionary;
+            schema->release      = release_schema;
+            schema->private_data = data.release();
+        }
+
+        void fill_array(std::unique_ptr<detail::arrow_node> node, ArrowArray* array)
+        {
+            auto data = std::make_unique<array_data>();
+
+            data->children.reserve(node->children.size());
+            for (auto& child : node->children)
+            {
+                auto c = std::make_unique<ArrowArray>();
+                fill_array(std::move(child), c.get());
+                data->children.push_back(c.release());
+            }
+            if (node->dictionary)
+            {
+                auto d = std::make_unique<ArrowArray>();
+                fill_array(std::move(node->dictionary), d.get());
+                data->dictionary = d.release();
+            }
+
+            array->length       = node->length;
+            array->null_count   = node->null_count;
+            array->offset       = 0;
+            array->n_buffers    = static_cast<int64_t>(node->buffers.size());
+            array->n_children   = static_cast<int64_t>(data->children.size());
+            array->buffers      = node->buffers.data();
+            array->children     = data->children.empty() ? nullptr : data->children.data();
+            array->dictionary   = data->dictionary;
+            array->release      = release_array;
+            data->node          = std::move(node);
+            array->private_data = data.release();
+        }
+    }  // namespace
+
+    namespace detail
+    {
+        const void* arrow_node::empty_buffer() noexcept { return empty; }
+
+        void export_arrow(std::unique_ptr<arrow_node> node, ArrowSchema* schema, ArrowArray* array)
+        {
+            fill_schema(*node, schema);
+            fill_array(std::move(node), array);
+        }
+    }  // namespace detail
+
+    ////////////////////////////////////////////////////////////////
+    // column.
+    ////////////////////////////////////////////////////////////////
+
+    std::unique_ptr<detail::arrow_node> column::release_validity()
+    {
+        auto node        = std::make_unique<detail::arrow_node>();
+        node->name       = name;
+        node->flags      = ARROW_FLAG_NULLABLE;
+        node->length     = static_cast<int64_t>(size());
+        node->null_count = static_cast<int64_t>(null_count);
+        node->add_buffer(validity.release());
+        null_count = 0;
+        return node;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // operand_column.
+    ////////////////////////////////////////////////////////////////
+
+    void operand_column::append(const std::vector<std::string>& operands)
+    {
+        for (const auto& operand : operands)
+        {
+            auto index = 0;
+            if (const auto it = lookup.find(operand); it != lookup.end())
+                index = it->second;
+            else
+            {
+                if (dictionary.size() == static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+                    throw_exception("The dictionary of operands is full"s);
+                index = static_cast<int32_t>(dictionary.size());
+                dictionary.push_back(operand);
+                lookup.try_emplace(operand, index);
+            }
+            indices.push_back(index);
+        }
+        offsets.push_back(static_cast<int64_t>(indices.size()));
+    }
+
+    void operand_column::reserve(const size_t rows) { offsets.reserve(rows + 1); }
+
+    std::unique_ptr<detail::arrow_node> operand_column::release()
+    {
+        auto node    = std::make_unique<detail::arrow_node>();
+        node->format = "+L";
+        node->name   = "operands";
+        node->length = static_cast<int64_t>(size());
+        node->buffers.push_back(nullptr);
+        node->add_buffer(std::move(offsets));
+        offsets = {0};
+
+        auto child    = std::make_unique<detail::arrow_node>();
+        child->format = "i";
+        child->name   = "item";
+        child->length = static_cast<int64_t>(indices.size());
+        child->buffers.push_back(nullptr);
+        child->add_buffer(std::move(indices));
+        indices = {};
+
+        auto dict    = std::make_unique<detail::arrow_node>();
+        dict->length = static_cast<int64_t>(dictionary.size());
+        dict->buffers.push_back(nullptr);
+        dictionary.release(*dict);
+        lookup.clear();
+
+        child->dictionary = std::move(dict);
+        node->children.emplace_back(std::move(child));
+        return node;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // column_batch.
+    ////////////////////////////////////////////////////////////////
+
+    std::shared_ptr<const flag_column> column_batch::add_column(const flag_ptr& f, std::string name)
+    {
+        check_column(f);
+        auto c = std::make_shared<flag_column>(f, column_name(*f, std::move(name)));
+        columns.emplace_back(c);
+        return c;
+    }
+
+    void column_batch::reserve(const size_t rows)
+    {
+        for (const auto& c : columns) c->reserve(rows);
+        operands.reserve(rows);
+    }
+
+    void column_batch::export_arrow(ArrowSchema* schema, ArrowArray* array)
+    {
+        auto node    = std::make_unique<detail::arrow_node>();
+        node->format = "+s";
+        node->length = static_cast<int64_t>(size());
+        node->buffers.push_back(nullptr);
+        node->children.reserve(columns.size() + 1);
+        for (const auto& c : columns) node->children.emplace_back(c->release());
+        node->children.emplace_back(operands.release());
+
+        detail::export_arrow(std::move(node), schema, array);
+    }
+
+    void column_batch::check_column(const argument_ptr& arg) const
+    {
+        if (!arg) throw_exception("The argument of a column should not be null"s);
+        if (size() > 0) throw_exception("Cannot add a column to a batch that holds rows"s);
+    }
+
+    bool column_batch::belongs_to(const std::vector<argument_ptr>& arguments) const noexcept
+    {
+        return std::ranges::all_of(columns, [&arguments](const std::shared_ptr<column>& c) {
+            return c->arg->index < arguments.size() && arguments[c->arg->index] == c->arg;
+        });
+    }
+
+    std::string column_batch::column_name(const argument& arg, std::string name)
+    {
+        if (!name.empty()) return name;
+        if (!arg.long_name.empty()) return arg.long_name;
+        return std::string(1, arg.short_name);
+    }
+
+    void column_batch::append(const std::vector<std::string>& operand_list)
+    {
+        for (const auto& c : columns) c->append();
+        operands.append(operand_list);
+    }
+}  // namespace pt
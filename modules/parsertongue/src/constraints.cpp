@@ -0,0 +1,118 @@
+#include "parsertongue/constraints.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <bit>
+#include <string>
+
+using namespace std::string_literals;
+
+namespace pt
+{
+    std::string constraints::names(const std::vector<argument_ptr>& arguments,
+                                   const std::vector<uint64_t>&     passed,
+                                   const std::vector<mask_word>&    mask,
+                                   const selection                  sel)
+    {
+        std::string s;
+        for (const auto& [word, mask_bits] : mask)
+        {
+            auto bits = mask_bits;
+            if (sel == selection::passed) bits &= passed[word];
+            if (sel == selection::missing) bits &= ~passed[word];
+
+            while (bits)
+            {
+                const auto& arg = arguments[word * 64 + static_cast<size_t>(std::countr_zero(bits))];
+                bits &= bits - 1;
+                if (!s.empty()) s.append({' '});
+                s.append(arg->get_pretty_name());
+            }
+        }
+        return s;
+    }
+
+    void constraints::add(const type constraint_type, const argument* trigger, const std::vector<const argument*>& args)
+    {
+        constraint c{
+          .constraint_type = constraint_type, .trigger = trigger ? trigger->index : 0, .size = 0, .mask = {}};
+
+        // Compile into a mask that only stores the non-empty words, sorted by word index.
+        for (const auto* arg : args)
+        {
+            const auto word = arg->index / 64;
+            const auto bit  = uint64_t{1} << (arg->index % 64);
+            auto       it   = std::ranges::lower_bound(c.mask, word, {}, &mask_word::word);
+            if (it == c.mask.end() || it->word != word) it = c.mask.insert(it, mask_word{.word = word});
+            if (!(it->bits & bit)) c.size++;
+            it->bits |= bit;
+        }
+
+        list.emplace_back(std::move(c));
+    }
+
+    bool constraints::empty() const noexcept { return list.empty(); }
+
+    void constraints::check(const std::vector<argument_ptr>& arguments, std::vector<parse_error_t>& parse_errors) const
+    {
+        // Gather which arguments were passed.
+        std::vector<uint64_t> passed((arguments.size() + 63) / 64, 0);
+        for (const auto& arg : arguments)
+        {
+            if (arg->has_value()) passed[arg->index / 64] |= uint64_t{1} << (arg->index % 64);
+        }
+
+        for (const auto& c : list)
+        {
+            if (c.constraint_type == type::dependency && !((passed[c.trigger / 64] >> (c.trigger % 64)) & 1)) continue;
+
+            size_t count = 0;
+            for (const auto& [word, bits] : c.mask) count += static_cast<size_t>(std::popcount(passed[word] & bits));
+
+            // Only build names when there is a violation.
+            const auto error = [&](const parse_error e, const selection sel, const std::string& message) {
+                auto n = names(arguments, passed, c.mask, sel);
+                parse_errors.emplace_back(e, n, message + n);
+            };
+
+            switch (c.constraint_type)
+            {
+            case type::required:
+                if (count < c.size)
+                    error(parse_error::missing_required, selection::missing, "missing required argument(s) "s);
+                break;
+            case type::dependency:
+                if (count < c.size)
+                {
+                    const auto& trigger = arguments[c.trigger];
+                    error(parse_error::missing_dependency,
+                          selection::missing,
+                          trigger->get_pretty_name() + " requires argument(s) "s);
+                }
+                break;
+            case type::conflict:
+                if (count > 1)
+                    error(
+                      parse_error::conflicting_arguments, selection::passed, "arguments cannot be passed together: "s);
+                break;
+            case type::exactly_one:
+                if (count > 1)
+                    error(parse_error::conflicting_arguments,
+                          selection::passed,
+                          "only one of these arguments can be passed: "s);
+                if (count == 0)
+                    error(parse_error::missing_one_of, selection::all, "one of these arguments is required: "s);
+                break;
+            case type::at_least_one:
+                if (count == 0)
+                    error(parse_error::missing_one_of,
+                          selection::all,
+                          "at least one of these arguments is required: "s);
+                break;
+            }
+        }
+    }
+}  // namespace pt
@@ -0,0 +1,271 @@
+#include "parsertongue/converters.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <numeric>
+
+namespace pt::detail
+{
+    namespace
+    {
+        constexpr uint64_t max_u64 = std::numeric_limits<uint64_t>::max();
+
+        bool is_digit(const char c) noexcept { return c >= '0' && c <= '9'; }
+
+        bool checked_add(const uint64_t a, const uint64_t b, uint64_t& out) noexcept
+        {
+            if (a > max_u64 - b) return false;
+            out = a + b;
+            return true;
+        }
+
+        bool checked_mul(const uint64_t a, const uint64_t b, uint64_t& out) noexcept
+        {
+            if (b != 0 && a > max_u64 / b) return false;
+            out = a * b;
+            return true;
+        }
+
+        /**
+         * \brief Parse a decimal number digits[.digits] and multiply it by a unit. The result must be a whole number.
+         * \param number Number.
+         * \param unit Unit.
+         * \param out Result.
+         * \return False if number is invalid, overflows or is not a whole number of units.
+         */
+        bool parse_scaled(std::string_view number, const uint64_t unit, uint64_t& out) noexcept
+        {
+            const auto dot     = number.find('.');
+            const auto integer = number.substr(0, dot);
+            auto fraction      = dot == std::string_view::npos ? std::string_view{} : number.substr(dot + 1);
+            if (integer.empty() || (dot != std::string_view::npos && fraction.empty())) return false;
+
+            uint64_t i   = 0;
+            const auto r = std::from_chars(integer.data(), integer.data() + integer.size(), i);
+            if (r.ec != std::errc() || r.ptr != integer.data() + integer.size()) return false;
+            if (!checked_mul(i, unit, out)) return false;
+
+            if (!std::ranges::all_of(fraction, is_digit)) return false;
+            while (!fraction.empty() && fraction.back() == '0') fraction.remove_suffix(1);
+            if (fraction.empty()) return true;
+            if (fraction.size() > 19) return false;
+
+            // out += f * unit / 10^k, which must be exact: 10^k / gcd must divide f.
+            uint64_t f = 0, pow10 = 1;
+            for (const auto c : fraction)
+            {
+                f = f * 10 + static_cast<uint64_t>(c - '0');
+                pow10 *= 10;
+            }
+            const auto g = std::gcd(unit, pow10);
+            if (f % (pow10 / g) != 0) return false;
+            uint64_t frac = 0;
+            return checked_mul(f / (pow10 / g), unit / g, frac) && checked_add(out, frac, out);
+        }
+
+        bool parse_ipv4(const std::string_view arg, uint8_t* bytes) noexcept
+        {
+            size_t begin = 0;
+            for (size_t i = 0; i < 4; i++)
+            {
+                const auto end = i == 3 ? arg.size() : arg.find('.', begin);
+                if (end == std::string_view::npos) return false;
+                const auto part = arg.substr(begin, end - begin);
+
+                // No leading zeros, which are ambiguous with octal notation.
+                if (part.empty() || part.size() > 3 || (part.size() > 1 && part.front() == '0')) return false;
+                uint8_t    b    = 0;
+                const auto r    = std::from_chars(part.data(), part.data() + part.size(), b);
+                if (r.ec != std::errc() || r.ptr != part.data() + part.size()) return false;
+                bytes[i] = b;
+                begin    = end + 1;
+            }
+            return true;
+        }
+
+        bool parse_ipv6(const std::string_view arg, uint8_t* bytes) noexcept
+        {
+            std::array<uint16_t, 8> groups{};
+            size_t                  n   = 0;
+            size_t                  gap = std::string_view::npos;
+            size_t                  i   = 0;
+
+            if (arg.starts_with("::"))
+            {
+                gap = 0;
+                i   = 2;
+            }
+            else if (arg.starts_with(':'))
+                return false;
+
+            while (i < arg.size())
+            {
+                const auto end   = arg.find(':', i);
+                const auto token = arg.substr(i, end == std::string_view::npos ? std::string_view::npos : end - i);
+
+                // Trailing IPv4 address takes the last two groups.
+                if (token.find('.') != std::string_view::npos)
+                {
+                    if (end != std::string_view::npos || n > 6) return false;
+                    std::array<uint8_t, 4> v4{};
+                    if (!parse_ipv4(token, v4.data())) return false;
+                    groups[n++] = static_cast<uint16_t>(v4[0] << 8 | v4[1]);
+                    groups[n++] = static_cast<uint16_t>(v4[2] << 8 | v4[3]);
+                    break;
+                }
+
+                if (token.empty() || token.size() > 4 || n == groups.size()) return false;
+                uint16_t   g = 0;
+                const auto r = std::from_chars(token.data(), token.data() + token.size(), g, 16);
+                if (r.ec != std::errc() || r.ptr != token.data() + token.size()) return false;
+                groups[n++] = g;
+
+                if (end == std::string_view::npos) break;
+                if (end + 1 < arg.size() && arg[end + 1] == ':')
+                {
+                    if (gap != std::string_view::npos) return false;
+                    gap = n;
+                    i   = end + 2;
+                }
+                else
+                {
+                    i = end + 1;
+                    if (i == arg.size()) return false;
+                }
+            }
+
+            if (gap == std::string_view::npos)
+            {
+                if (n != groups.size()) return false;
+            }
+            else
+            {
+                // :: replaces at least one group.
+                if (n == groups.size()) return false;
+                const auto tail = n - gap;
+                std::copy_backward(groups.begin() + static_cast<ptrdiff_t>(gap),
+                                   groups.begin() + static_cast<ptrdiff_t>(n),
+                                   groups.end());
+                std::fill_n(groups.begin() + static_cast<ptrdiff_t>(gap), groups.size() - tail - gap, uint16_t{0});
+            }
+
+            for (size_t j = 0; j < groups.size(); j++)
+            {
+                bytes[j * 2]     = static_cast<uint8_t>(groups[j] >> 8);
+                bytes[j * 2 + 1] = static_cast<uint8_t>(groups[j] & 0xff);
+            }
+            return true;
+        }
+    }  // namespace
+
+    bool parse_duration(std::string_view arg, int64_t& ns) noexcept
+    {
+        struct unit
+        {
+            std::string_view name;
+            uint64_t         ns;
+        };
+
+        constexpr std::array<unit, 8> units = {unit{"ns", 1},
+                                               unit{"us", 1'000},
+                                               unit{"ms", 1'000'000},
+                                               unit{"s", 1'000'000'000},
+                                               unit{"m", 60'000'000'000},
+                                               unit{"min", 60'000'000'000},
+                                               unit{"h", 3'600'000'000'000},
+                                               unit{"d", 86'400'000'000'000}};
+
+        const auto negative = arg.starts_with('-');
+        if (negative || arg.starts_with('+')) arg.remove_prefix(1);
+        if (arg.empty()) return false;
+
+        uint64_t total = 0;
+        while (!arg.empty())
+        {
+            const auto number_end = std::ranges::find_if(arg, [](const char c) { return !is_digit(c) && c != '.'; });
+            const auto unit_end   = std::find_if(number_end, arg.end(), [](const char c) { return is_digit(c); });
+            const auto number     = std::string_view(arg.begin(), number_end);
+            const auto name       = std::string_view(number_end, unit_end);
+
+            const auto u = std::ranges::find(units, name, &unit::name);
+            if (u == units.end()) return false;
+
+            uint64_t component = 0;
+            if (!parse_scaled(number, u->ns, component) || !checked_add(total, component, total)) return false;
+            arg.remove_prefix(static_cast<size_t>(unit_end - arg.begin()));
+        }
+
+        constexpr auto max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+        if (total > max + (negative ? 1 : 0)) return false;
+        ns = negative ? static_cast<int64_t>(0 - total) : static_cast<int64_t>(total);
+        return true;
+    }
+
+    bool parse_byte_size(const std::string_view arg, uint64_t& bytes) noexcept
+    {
+        const auto number_end = std::ranges::find_if(arg, [](const char c) { return !is_digit(c) && c != '.'; });
+        const auto number     = std::string_view(arg.begin(), number_end);
+        auto       suffix     = std::string_view(number_end, arg.end());
+
+        // Optional prefix, followed by i for binary prefixes, followed by an optional B.
+        uint64_t unit = 1;
+        if (!suffix.empty() && suffix.front() != 'B')
+        {
+            constexpr std::string_view prefixes = "kmgtpe";
+            const auto                 c        = static_cast<char>(suffix.front() | 0x20);
+            const auto                 exponent = prefixes.find(c);
+            if (exponent == std::string_view::npos) return false;
+            suffix.remove_prefix(1);
+
+            const uint64_t base = suffix.starts_with('i') ? 1024 : 1000;
+            if (base == 1024) suffix.remove_prefix(1);
+            for (size_t i = 0; i <= exponent; i++) unit *= base;
+        }
+        if (suffix == "B") suffix.remove_prefix(1);
+        if (!suffix.empty()) return false;
+
+        return parse_scaled(number, unit, bytes);
+    }
+
+    bool parse_ip_address(const std::string_view arg, ip_address& address) noexcept
+    {
+        ip_address a;
+        if (arg.find(':') != std::string_view::npos)
+        {
+            a.type = ip_address::family::v6;
+            if (!parse_ipv6(arg, a.bytes.data())) return false;
+        }
+        else if (!parse_ipv4(arg, a.bytes.data()))
+            return false;
+        address = a;
+        return true;
+    }
+
+    bool parse_ip_endpoint(const std::string_view arg, ip_endpoint& endpoint) noexcept
+    {
+        const auto colon = arg.rfind(':');
+        if (colon == std::string_view::npos) return false;
+        auto       host = arg.substr(0, colon);
+        const auto port = arg.substr(colon + 1);
+
+        // IPv6 addresses must be enclosed in brackets to separate them from the port.
+        if (host.starts_with('['))
+        {
+            if (!host.ends_with(']') || host.size() < 3) return false;
+            host = host.substr(1, host.size() - 2);
+            if (host.find(':') == std::string_view::npos) return false;
+        }
+        else if (host.find(':') != std::string_view::npos)
+            return false;
+
+        ip_endpoint e;
+        if (!parse_ip_address(host, e.address)) return false;
+        const auto r = std::from_chars(port.data(), port.data() + port.size(), e.port);
+        if (port.empty() || r.ec != std::errc() || r.ptr != port.data() + port.size()) return false;
+        endpoint = e;
+        return true;
+    }
+}  // namespace pt::detail
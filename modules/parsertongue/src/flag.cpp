@@ -1,5 +1,18 @@
 #include "parsertongue/flag.h"
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <string_view>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
 #include "parsertongue/parser_tongue_exception.h"
 
 using namespace std::string_literals;
@@ -10,7 +23,7 @@ namespace pt
 
     bool flag::is_set() const
     {
-        if (!valid) throw parser_tongue_exception("Cannot retrieve value before running the parser"s);
+        if (!valid) throw_exception("Cannot retrieve value before running the parser"s);
         return value;
     }
 
@@ -18,5 +31,42 @@ namespace pt
     {
         valid = false;
         value = false;
+        write();
+    }
+
+    argument_state_ptr flag::save() const { return std::make_shared<flag_state>(value); }
+
+    void flag::restore(const argument_state& state) { set(static_cast<const flag_state&>(state).value); }
+
+    bool flag::has_value() const noexcept { return value; }
+
+    fingerprint flag::get_fingerprint() const noexcept { return {.low = 1, .high = 0}; }
+
+    void flag::parse_env(const std::string& arg, std::vector<parse_error_t>& parse_errors)
+    {
+        constexpr std::array<std::string_view, 4> enabled  = {"1", "true", "yes", "on"};
+        constexpr std::array<std::string_view, 5> disabled = {"", "0", "false", "no", "off"};
+
+        std::string lower(arg);
+        std::ranges::transform(lower, lower.begin(), [](const char c) {
+            return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        });
+
+        if (std::ranges::find(enabled, lower) != enabled.end())
+            set(true);
+        else if (std::ranges::find(disabled, lower) == disabled.end())
+            parse_errors.emplace_back(
+              parse_error::parsing_error, arg, arg + " is not a valid value for "s + get_pretty_name());
+    }
+
+    void flag::set(const bool v) noexcept
+    {
+        value = v;
+        write();
+    }
+
+    void flag::write() const noexcept
+    {
+        if (store) store(target, mask, value || initial);
     }
 }  // namespace pt
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////
+// Explicit instantiations of the templates for common types.
+// The headers declare these as extern templates, so that they
+// are compiled once here instead of in every user translation
+// unit.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/parser.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <string>
+
+namespace pt
+{
+    template std::expected<int, conversion_error> parse_value<int>(const std::string&);
+    template std::expected<int64_t, conversion_error> parse_value<int64_t>(const std::string&);
+    template std::expected<uint64_t, conversion_error> parse_value<uint64_t>(const std::string&);
+    template std::expected<double, conversion_error> parse_value<double>(const std::string&);
+    template std::expected<float, conversion_error> parse_value<float>(const std::string&);
+    template std::expected<bool, conversion_error> parse_value<bool>(const std::string&);
+    template std::expected<std::string, conversion_error> parse_value<std::string>(const std::string&);
+    template class value_state<int>;
+    template class value<int>;
+    template class value_state<int64_t>;
+    template class value<int64_t>;
+    template class value_state<uint64_t>;
+    template class value<uint64_t>;
+    template class value_state<double>;
+    template class value<double>;
+    template class value_state<float>;
+    template class value<float>;
+    template class value_state<bool>;
+    template class value<bool>;
+    template class value_state<std::string>;
+    template class value<std::string>;
+    template class list_state<int>;
+    template class list<int>;
+    template class list_state<int64_t>;
+    template class list<int64_t>;
+    template class list_state<uint64_t>;
+    template class list<uint64_t>;
+    template class list_state<double>;
+    template class list<double>;
+    template class list_state<float>;
+    template class list<float>;
+    template class list_state<bool>;
+    template class list<bool>;
+    template class list_state<std::string>;
+    template class list<std::string>;
+    template class map_state<std::string, std::string>;
+    template class map<std::string, std::string>;
+    template std::shared_ptr<value<int>> parser::add_value<int>(char, const std::string&);
+    template std::shared_ptr<list<int>> parser::add_list<int>(char, const std::string&);
+    template std::shared_ptr<value<int>> parser::add_operand<int>(const std::string&, bool);
+    template std::shared_ptr<list<int>> parser::add_operands<int>(const std::string&);
+    template std::shared_ptr<value<int64_t>> parser::add_value<int64_t>(char, const std::string&);
+    template std::shared_ptr<list<int64_t>> parser::add_list<int64_t>(char, const std::string&);
+    template std::shared_ptr<value<int64_t>> parser::add_operand<int64_t>(const std::string&, bool);
+    template std::shared_ptr<list<int64_t>> parser::add_operands<int64_t>(const std::string&);
+    template std::shared_ptr<value<uint64_t>> parser::add_value<uint64_t>(char, const std::string&);
+    template std::shared_ptr<list<uint64_t>> parser::add_list<uint64_t>(char, const std::string&);
+    template std::shared_ptr<value<uint64_t>> parser::add_operand<uint64_t>(const std::string&, bool);
+    template std::shared_ptr<list<uint64_t>> parser::add_operands<uint64_t>(const std::string&);
+    template std::shared_ptr<value<double>> parser::add_value<double>(char, const std::string&);
+    template std::shared_ptr<list<double>> parser::add_list<double>(char, const std::string&);
+    template std::shared_ptr<value<double>> parser::add_operand<double>(const std::string&, bool);
+    template std::shared_ptr<list<double>> parser::add_operands<double>(const std::string&);
+    template std::shared_ptr<value<float>> parser::add_value<float>(char, const std::string&);
+    template std::shared_ptr<list<float>> parser::add_list<float>(char, const std::string&);
+    template std::shared_ptr<value<float>> parser::add_operand<float>(const std::string&, bool);
+    template std::shared_ptr<list<float>> parser::add_operands<float>(const std::string&);
+    template std::shared_ptr<value<bool>> parser::add_value<bool>(char, const std::string&);
+    template std::shared_ptr<list<bool>> parser::add_list<bool>(char, const std::string&);
+    template std::shared_ptr<value<bool>> parser::add_operand<bool>(const std::string&, bool);
+    template std::shared_ptr<list<bool>> parser::add_operands<bool>(const std::string&);
+    template std::shared_ptr<value<std::string>> parser::add_value<std::string>(char, const std::string&);
+    template std::shared_ptr<list<std::string>> parser::add_list<std::string>(char, const std::string&);
+    template std::shared_ptr<value<std::string>> parser::add_operand<std::string>(const std::string&, bool);
+    template std::shared_ptr<list<std::string>> parser::add_operands<std::string>(const std::string&);
+    template std::shared_ptr<map<std::string, std::string>>
+      parser::add_map<std::string, std::string>(char, const std::string&);
+}  // namespace pt
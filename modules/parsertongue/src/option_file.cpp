@@ -0,0 +1,229 @@
+#include "parsertongue/option_file.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <condition_variable>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/push_parser.h"
+
+////////////////////////////////////////////////////////////////
+// Platform includes.
+////////////////////////////////////////////////////////////////
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace pt
+{
+    using namespace std::string_literals;
+
+    namespace
+    {
+        bool read_file(const std::filesystem::path& path, std::string& contents)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) return false;
+            contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            return !file.bad();
+        }
+
+        /**
+         * \brief Feed all lines that are not comments to a push parser.
+         */
+        bool feed_lines(push_parser& push, const std::string_view contents, std::string& error)
+        {
+            size_t begin = 0;
+            while (begin < contents.size())
+            {
+                auto end = contents.find('\n', begin);
+                if (end == std::string_view::npos) end = contents.size();
+                const auto line  = contents.substr(begin, end - begin);
+                const auto first = line.find_first_not_of(" \t\r");
+                begin            = end + 1;
+
+                if (first == std::string_view::npos || line[first] == '#') continue;
+                if (!push.feed(line, error) || !push.feed("\n", error)) return false;
+            }
+            return true;
+        }
+    }  // namespace
+
+    option_file::option_file(parser p, std::filesystem::path path) : p(std::move(p)), path(std::move(path))
+    {
+        if (this->p.parsed) throw_exception("Cannot create an option file from a parser that was already run"s);
+    }
+
+    option_file::~option_file() noexcept { stop(); }
+
+    void option_file::on_change(const argument_ptr& arg, change_callback callback)
+    {
+        if (watcher.joinable()) throw_exception("Cannot add a callback while watching the file"s);
+        if (!arg || arg->index >= p.argument_objects.size() || p.argument_objects[arg->index] != arg)
+            throw_exception("The argument does not belong to the parser of the option file"s);
+        callbacks.emplace_back(arg->index, std::move(callback));
+    }
+
+    void option_file::on_error(error_callback callback)
+    {
+        if (watcher.joinable()) throw_exception("Cannot add a callback while watching the file"s);
+        error_handler = std::move(callback);
+    }
+
+    bool option_file::load(std::string& error)
+    {
+        std::scoped_lock lock(mutex);
+
+        std::string contents;
+        if (!read_file(path, contents))
+        {
+            error = std::format("Cannot read {0}", path.string());
+            return false;
+        }
+
+        // Only the file is parsed again, the rest of the application is not affected.
+        p.reset(std::vector<std::string>{});
+        push_parser push(p);
+        if (!feed_lines(push, contents, error) || !push.finish(error)) return false;
+        if (const auto& errors = p.get_errors(); !errors.empty())
+        {
+            error = std::format("{0}: {1}", path.string(), std::get<2>(errors.front()));
+            return false;
+        }
+
+        auto snapshot    = std::make_shared<option_snapshot>();
+        snapshot->result = p.get_result();
+        snapshot->states = snapshot->result->states;
+        snapshot->digests.reserve(p.argument_objects.size());
+        for (const auto& arg : p.argument_objects)
+            snapshot->digests.emplace_back(arg->has_value() ? std::optional(arg->get_fingerprint()) : std::nullopt);
+
+        // Keep the current snapshot if nothing changed, so that readers can compare pointers.
+        const auto previous = current.load();
+        if (previous && previous->digests == snapshot->digests &&
+            previous->result->get_operands() == snapshot->result->get_operands())
+            return true;
+
+        snapshot->version = ++loads;
+        current.store(snapshot);
+
+        for (const auto& [index, callback] : callbacks)
+        {
+            if (!previous || previous->digests[index] != snapshot->digests[index]) callback(*snapshot);
+        }
+
+        return true;
+    }
+
+    void option_file::watch(const std::chrono::milliseconds interval)
+    {
+        if (watcher.joinable()) throw_exception("The file is already watched"s);
+        watcher = std::jthread([this, interval](const std::stop_token& token) { run(token, interval); });
+    }
+
+    void option_file::stop() noexcept
+    {
+        if (!watcher.joinable()) return;
+        watcher.request_stop();
+        watcher.join();
+    }
+
+    option_snapshot_ptr option_file::get() const noexcept { return current.load(); }
+
+    const std::filesystem::path& option_file::get_path() const noexcept { return path; }
+
+    void option_file::run(const std::stop_token& token, const std::chrono::milliseconds interval)
+    {
+#ifdef __linux__
+        if (run_inotify(token, interval)) return;
+#endif
+        run_polling(token, interval);
+    }
+
+#ifdef __linux__
+    bool option_file::run_inotify(const std::stop_token& token, const std::chrono::milliseconds interval)
+    {
+        const auto fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0) return false;
+
+        // Watch the directory, because editors often replace the file instead of writing to it.
+        const auto dir = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+        if (inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        const auto name = path.filename().string();
+        alignas(inotify_event) std::array<char, 4096> buffer;
+        while (!token.stop_requested())
+        {
+            pollfd pfd{.fd = fd, .events = POLLIN, .revents = 0};
+            if (poll(&pfd, 1, static_cast<int>(interval.count())) <= 0) continue;
+
+            auto changed = false;
+            for (ssize_t n; (n = read(fd, buffer.data(), buffer.size())) > 0;)
+            {
+                for (ssize_t i = 0; i < n;)
+                {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + i);
+                    if (event->len > 0 && name == event->name) changed = true;
+                    i += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                }
+            }
+
+            if (changed) reload();
+        }
+
+        close(fd);
+        return true;
+    }
+#endif
+
+    void option_file::run_polling(const std::stop_token& token, const std::chrono::milliseconds interval)
+    {
+        const auto stamp = [this] {
+            std::error_code ec;
+            const auto      time = std::filesystem::last_write_time(path, ec);
+            const auto      size = std::filesystem::file_size(path, ec);
+            return std::pair(time, size);
+        };
+
+        std::mutex                  wait_mutex;
+        std::condition_variable_any wait;
+        auto                        last = stamp();
+        while (!token.stop_requested())
+        {
+            // Wakes up early when a stop is requested.
+            std::unique_lock lock(wait_mutex);
+            static_cast<void>(wait.wait_for(lock, token, interval, [] { return false; }));
+            if (token.stop_requested()) break;
+
+            if (const auto s = stamp(); s != last)
+            {
+                last = s;
+                reload();
+            }
+        }
+    }
+
+    void option_file::reload()
+    {
+        std::string error;
+        if (!detail::guard([&] { return load(error); }, error) && error_handler) error_handler(error);
+    }
+}  // namespace pt
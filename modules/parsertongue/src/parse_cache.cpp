@@ -0,0 +1,122 @@
+#include "parsertongue/parse_cache.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <functional>
+#include <string_view>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/parser_tongue_exception.h"
+
+using namespace std::string_literals;
+
+namespace pt
+{
+    namespace
+    {
+        /**
+         * \brief Check if the environment variables that were read for a result still have the same values.
+         */
+        bool matches_environment(const parse_result& result)
+        {
+            for (const auto& [name, value] : result.get_environment())
+            {
+                const auto* current = std::getenv(name.c_str());
+                if (current ? !value || *value != current : value.has_value()) return false;
+            }
+            return true;
+        }
+    }  // namespace
+
+    parse_cache::parse_cache(const size_t capacity) : capacity(capacity)
+    {
+        if (capacity == 0) throw_exception("The capacity of a parse cache should be at least 1"s);
+        lookup.reserve(capacity);
+    }
+
+    parse_result_ptr parse_cache::find(const std::vector<std::string>& arguments)
+    {
+        const auto h = hash(arguments);
+
+        std::scoped_lock lock(mutex);
+
+        // Compare the full list of arguments to rule out hash collisions.
+        const auto [first, last] = lookup.equal_range(h);
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->second->second->get_arguments() != arguments) continue;
+            if (!matches_environment(*it->second->second)) continue;
+
+            entries.splice(entries.begin(), entries, it->second);
+            stats.hits++;
+            return it->second->second;
+        }
+
+        stats.misses++;
+        return nullptr;
+    }
+
+    void parse_cache::insert(parse_result_ptr result)
+    {
+        const auto h = hash(result->get_arguments());
+
+        std::scoped_lock lock(mutex);
+
+        // Another thread might have inserted the same arguments in the meantime.
+        const auto [first, last] = lookup.equal_range(h);
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->second->second->get_arguments() == result->get_arguments() &&
+                it->second->second->get_environment() == result->get_environment())
+                return;
+        }
+
+        if (entries.size() == capacity)
+        {
+            const auto oldest = entries.back().first;
+            for (auto [it, end] = lookup.equal_range(oldest); it != end; ++it)
+            {
+                if (it->second == std::prev(entries.end()))
+                {
+                    lookup.erase(it);
+                    break;
+                }
+            }
+            entries.pop_back();
+            stats.evictions++;
+        }
+
+        entries.emplace_front(h, std::move(result));
+        lookup.emplace(h, entries.begin());
+    }
+
+    void parse_cache::clear()
+    {
+        std::scoped_lock lock(mutex);
+        entries.clear();
+        lookup.clear();
+    }
+
+    parse_cache::statistics parse_cache::get_statistics() const
+    {
+        std::scoped_lock lock(mutex);
+        auto             s = stats;
+        s.size             = entries.size();
+        return s;
+    }
+
+    uint64_t parse_cache::hash(const std::vector<std::string>& arguments) noexcept
+    {
+        // Combine the hashes of all arguments in order.
+        uint64_t h = arguments.size();
+        for (const auto& arg : arguments)
+            h ^= std::hash<std::string_view>{}(arg) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+        return h;
+    }
+}  // namespace pt
@@ -16,6 +16,20 @@ namespace pt
         case parse_error::unknown_long_name: out << "unknown_long_name"s; break;
         case parse_error::missing_value: out << "missing_value"s; break;
         case parse_error::parsing_error: out << "parsing_error"s; break;
+        case parse_error::unterminated_quote: out << "unterminated_quote"s; break;
+        case parse_error::too_many_arguments: out << "too_many_arguments"s; break;
+        case parse_error::argument_too_long: out << "argument_too_long"s; break;
+        case parse_error::input_too_large: out << "input_too_large"s; break;
+        case parse_error::too_many_operands: out << "too_many_operands"s; break;
+        case parse_error::too_many_list_elements: out << "too_many_list_elements"s; break;
+        case parse_error::too_many_errors: out << "too_many_errors"s; break;
+        case parse_error::missing_required: out << "missing_required"s; break;
+        case parse_error::missing_dependency: out << "missing_dependency"s; break;
+        case parse_error::conflicting_arguments: out << "conflicting_arguments"s; break;
+        case parse_error::missing_one_of: out << "missing_one_of"s; break;
+        case parse_error::ambiguous_long_name: out << "ambiguous_long_name"s; break;
+        case parse_error::validation_failed: out << "validation_failed"s; break;
+        case parse_error::duplicate_key: out << "duplicate_key"s; break;
         }
 
         out << ": "s << std::get<2>(e) << '\n';
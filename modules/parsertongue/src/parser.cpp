@@ -5,8 +5,20 @@
 ////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <format>
+#include <iterator>
+#include <typeinfo>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/columnar.h"
+#include "parsertongue/parse_cache.h"
+#include "parsertongue/recorder.h"
+#include "parsertongue/telemetry.h"
 
 ////////////////////////////////////////////////////////////////
 // Platform specific includes.
@@ -20,6 +32,7 @@
 #include <WinBase.h>
 #else
 #include <wordexp.h>
+extern char** environ;
 #endif
 
 using namespace std::string_literals;
@@ -40,9 +53,48 @@ namespace pt
 
     void parser::set_description(std::string app_description) { description = std::move(app_description); }
 
+    void parser::set_env_prefix(std::string prefix)
+    {
+        if (parsed) throw_exception("Cannot set environment prefix after running the parser"s);
+        env_prefix = std::move(prefix);
+    }
+
+    void parser::set_string_pool(std::shared_ptr<string_pool> string_pool)
+    {
+        if (parsed) throw_exception("Cannot set string pool after running the parser"s);
+        pool = std::move(string_pool);
+    }
+
+    void parser::set_telemetry(std::shared_ptr<telemetry> sink)
+    {
+        if (parsed) throw_exception("Cannot set telemetry after running the parser"s);
+        telemetry_sink = std::move(sink);
+    }
+
+    void parser::set_batch(std::shared_ptr<column_batch> batch)
+    {
+        if (parsed) throw_exception("Cannot set batch after running the parser"s);
+        if (batch && !batch->belongs_to(argument_objects))
+            throw_exception("The columns of the batch do not belong to this parser"s);
+        batch_sink = std::move(batch);
+    }
+
+    void parser::set_recorder(std::shared_ptr<recorder> rec)
+    {
+        if (parsed) throw_exception("Cannot set recorder after running the parser"s);
+        if (rec) rec->attach(argument_objects);
+        recording_sink = std::move(rec);
+    }
+
+    void parser::set_abbreviations(const bool enabled)
+    {
+        if (parsed) throw_exception("Cannot set abbreviations after running the parser"s);
+        abbreviations = enabled;
+    }
+
     flag_ptr parser::add_flag(const char short_name, const std::string& long_name)
     {
-        if (parsed) throw parser_tongue_exception("Cannot add flag after running the parser"s);
+        if (parsed) throw_exception("Cannot add flag after running the parser"s);
 
         auto use_short = false;
         auto use_long  = false;
@@ -51,6 +103,7 @@ namespace pt
 
         // Create and store flag.
         auto ptr = std::make_shared<flag>(short_name, long_name);
+        ptr->index = argument_objects.size();
         argument_objects.push_back(ptr);
         if (use_short) flags[short_name] = ptr;
         if (use_long) flags_long[long_name] = ptr;
@@ -58,6 +111,103 @@ namespace pt
         return ptr;
     }
 
+    bytes_ptr parser::add_bytes(const char short_name, const std::string& long_name, const binary_encoding encoding)
+    {
+        if (parsed) throw_exception("Cannot add value after running the parser"s);
+
+        auto use_short = false;
+        auto use_long  = false;
+
+        check_names(short_name, long_name, use_short, use_long);
+
+        // Create and store value.
+        auto ptr   = std::make_shared<bytes_value>(short_name, long_name, encoding);
+        ptr->index = argument_objects.size();
+        argument_objects.push_back(ptr);
+        if (use_short) values[short_name] = ptr;
+        if (use_long) values_long[long_name] = ptr;
+
+        return ptr;
+    }
+
+    flag_ptr parser::bind_flag(bool& target, const char short_name, const std::string& long_name)
+    {
+        return add_bound_flag(
+          &target,
+          1,
+          target,
+          [](void* t, uint64_t, const bool value) noexcept { *static_cast<bool*>(t) = value; },
+          short_name,
+          long_name);
+    }
+
+    flag_ptr parser::add_bound_flag(void* const        target,
+                                    const uint64_t     mask,
+                                    const bool         initial,
+                                    void (*store)(void*, uint64_t, bool) noexcept,
+                                    const char         short_name,
+                                    const std::string& long_name)
+    {
+        if (parsed) throw_exception("Cannot add flag after running the parser"s);
+
+        auto use_short = false;
+        auto use_long  = false;
+
+        check_names(short_name, long_name, use_short, use_long);
+
+        // Create and store flag.
+        auto ptr     = create_bound<flag>(short_name, long_name);
+        ptr->index   = argument_objects.size();
+        ptr->target  = target;
+        ptr->mask    = mask;
+        ptr->initial = initial;
+        ptr->store   = store;
+        argument_objects.push_back(ptr);
+        if (use_short) flags[short_name] = ptr;
+        if (use_long) flags_long[long_name] = ptr;
+
+        return ptr;
+    }
+
+    void parser::add_required(const std::vector<argument_ptr>& args)
+    {
+        add_constraint(constraints::type::required, nullptr, args);
+    }
+
+    void parser::add_dependency(const argument_ptr& trigger, const std::vector<argument_ptr>& args)
+    {
+        add_constraint(constraints::type::dependency, trigger, args);
+    }
+
+    void parser::add_conflict(const std::vector<argument_ptr>& args)
+    {
+        add_constraint(constraints::type::conflict, nullptr, args);
+    }
+
+    void parser::add_exactly_one_of(const std::vector<argument_ptr>& args)
+    {
+        add_constraint(constraints::type::exactly_one, nullptr, args);
+    }
+
+    void parser::add_at_least_one_of(const std::vector<argument_ptr>& args)
+    {
+        add_constraint(constraints::type::at_least_one, nullptr, args);
+    }
+
+    void parser::set_limits(const parse_limits& parse_limits)
+    {
+        if (parsed) throw_exception("Cannot set limits after running the parser"s);
+        limits = parse_limits;
+    }
+
+    const parse_limits& parser::get_limits() const noexcept { return limits; }
+
+    void parser::set_cache(std::shared_ptr<parse_cache> parse_cache)
+    {
+        if (parsed) throw_exception("Cannot set cache after running the parser"s);
+        cache = std::move(parse_cache);
+    }
+
     const std::vector<std::string>& parser::get_arguments() const noexcept { return arguments; }
 
     std::string parser::get_full_string() const
@@ -81,7 +231,7 @@ namespace pt
 
     const std::vector<parse_error_t>& parser::get_errors() const
     {
-        if (!parsed) throw parser_tongue_exception("Cannot get errors before running the parser"s);
+        if (!parsed) throw_exception("Cannot get errors before running the parser"s);
         return parse_errors;
     }
 
@@ -179,8 +329,14 @@ namespace pt
                         col += 3;
                     }
 
+                    // Print name of positional argument.
+                    if (arg->positional)
+                    {
+                        out << '<' << arg->long_name << "> "s;
+                        col += arg->long_name.size() + 3;
+                    }
                     // Print long name.
-                    if (!arg->long_name.empty())
+                    else if (!arg->long_name.empty())
                     {
                         out << "--"s << arg->long_name << ' ';
                         col += arg->long_name.size() + 3;
@@ -226,44 +382,96 @@ namespace pt
 
     void parser::display_errors(std::ostream& out) const
     {
-        if (!parsed) throw parser_tongue_exception("Cannot display errors before running the parser"s);
+        if (!parsed) throw_exception("Cannot display errors before running the parser"s);
         for (const auto& e : parse_errors) out << e;
     }
 
     const std::vector<std::string>& parser::get_operands() const
     {
-        if (!parsed) throw parser_tongue_exception("Cannot get operands before running the parser"s);
+        if (!parsed) throw_exception("Cannot get operands before running the parser"s);
         return operands;
     }
 
+    parse_result_ptr parser::get_result() const
+    {
+        if (!parsed) throw_exception("Cannot get result before running the parser"s);
+        if (!result) result = save();
+        return result;
+    }
+
+    fingerprint parser::get_fingerprint() const
+    {
+        if (!parsed) throw_exception("Cannot get fingerprint before running the parser"s);
+
+        // Operands are ordered, so they are hashed as a sequence that is combined like an argument.
+        auto f = fingerprint_sum;
+        if (!operands.empty()) f += operand_hasher.digest();
+        return f;
+    }
+
     bool parser::operator()(std::string& error)
     {
-        if (parsed) throw parser_tongue_exception("Cannot run the parser multiple times"s);
+        if (parsed) throw_exception("Cannot run the parser multiple times"s);
         parsed = true;
 
-        try
-        {
-            run();
-        }
-        catch (std::exception& e)
-        {
-            error = e.what();
-            return false;
-        }
-
-        return true;
+        return detail::guard(
+          [this] {
+              if (cache)
+              {
+                  if (auto hit = cache->find(arguments))
+                  {
+                      begin();
+                      restore(*hit);
+                      result = std::move(hit);
+                      record();
+                      return true;
+                  }
+
+                  run();
+                  result = save();
+                  cache->insert(result);
+              }
+              else
+                  run();
+              return true;
+          },
+          error);
     }
 
-    void parser::reset(const std::string& args, const bool noProgramName)
+    void parser::reset(std::vector<std::string> args)
     {
         parsed = false;
         arguments.clear();
         operands.clear();
+        fingerprint_sum = {};
+        operand_hasher  = {};
         parse_errors.clear();
+        observations.clear();
+        environment.clear();
         requested_version = false;
         requested_help    = false;
+        stopped           = false;
+        token_count       = 0;
+        total_length      = 0;
+        positional_count  = 0;
+        active_value.reset();
+        active_list.reset();
+        result.reset();
+        resume_point.reset();
+
+        for (const auto& arg : argument_objects)
+        {
+            arg->reset();
+            arg->source       = value_source::none;
+            arg->contribution = {};
+        }
+
+        arguments = std::move(args);
+    }
 
-        for (const auto& arg : argument_objects) arg->reset();
+    void parser::reset(const std::string& args, const bool noProgramName)
+    {
+        reset(std::vector<std::string>{});
 
 #ifdef WIN32
         const auto   wchars_num = MultiByteToWideChar(CP_UTF8, 0, args.c_str(), -1, nullptr, 0);
@@ -292,96 +500,488 @@ namespace pt
         else
         {
             wordfree(&words);
-            throw parser_tongue_exception("Failed not parse string: \"{}\" "s, args);
+            throw_exception(std::format("Failed to parse string: \"{}\"", args));
         }
 
         wordfree(&words);
 #endif
     }
 
+    parse_checkpoint_ptr parser::make_checkpoint(std::vector<std::string> prefix)
+    {
+        reset(std::move(prefix));
+        begin();
+
+        for (const auto& arg : arguments)
+        {
+            if (!step(arg)) break;
+        }
+
+        auto checkpoint              = std::make_shared<parse_checkpoint>();
+        checkpoint->state            = save();
+        checkpoint->active_value     = active_value ? active_value->index : parse_checkpoint::npos;
+        checkpoint->active_list      = active_list ? active_list->index : parse_checkpoint::npos;
+        checkpoint->positional_count = positional_count;
+        checkpoint->token_count      = token_count;
+        checkpoint->total_length     = total_length;
+        checkpoint->stopped          = stopped;
+
+        reset(std::vector<std::string>{});
+        return checkpoint;
+    }
+
+    void parser::reset(parse_checkpoint_ptr checkpoint, std::vector<std::string> suffix)
+    {
+        if (!checkpoint) throw_exception("The checkpoint should not be null"s);
+        update_layout();
+        if (checkpoint->state->layout != layout)
+            throw_exception("Cannot resume from a checkpoint of a parser with different arguments"s);
+
+        std::vector<std::string> args;
+        args.reserve(checkpoint->get_arguments().size() + suffix.size());
+        args.insert(args.end(), checkpoint->get_arguments().begin(), checkpoint->get_arguments().end());
+        args.insert(args.end(), std::make_move_iterator(suffix.begin()), std::make_move_iterator(suffix.end()));
+
+        reset(std::move(args));
+        resume_point = std::move(checkpoint);
+    }
+
     void parser::run()
+    {
+        begin();
+
+        // Skip the prefix that was already parsed into the checkpoint.
+        size_t first = 0;
+        if (resume_point)
+        {
+            restore(*resume_point);
+            first = resume_point->get_arguments().size();
+        }
+
+        for (auto i = first; i < arguments.size(); i++)
+        {
+            if (!step(arguments[i])) break;
+        }
+
+        end();
+    }
+
+    void parser::begin()
     {
         // Mark all objects as valid.
         for (auto& [k, v] : flags) v->valid = true;
         for (auto& [k, v] : flags_long) v->valid = true;
-        for (auto& [k, v] : values) v->valid = true;
-        for (auto& [k, v] : values_long) v->valid = true;
-        for (auto& [k, v] : lists) { v->valid = true; }
-        for (auto& [k, v] : lists_long) { v->valid = true; }
+        for (auto& [k, v] : values)
+        {
+            check_dependencies(*v);
+            v->valid = true;
+            v->pool  = pool.get();
+        }
+        for (auto& [k, v] : values_long)
+        {
+            check_dependencies(*v);
+            v->valid = true;
+            v->pool  = pool.get();
+        }
+        for (auto& [k, v] : lists)
+        {
+            v->valid              = true;
+            v->max_elements       = limits.max_list_elements;
+            v->max_range_elements = limits.max_range_elements;
+            v->pool               = pool.get();
+        }
+        for (auto& [k, v] : lists_long)
+        {
+            v->valid              = true;
+            v->max_elements       = limits.max_list_elements;
+            v->max_range_elements = limits.max_range_elements;
+            v->pool               = pool.get();
+        }
+        for (auto& v : positionals)
+        {
+            check_dependencies(*v);
+            v->valid = true;
+            v->pool  = pool.get();
+        }
+        if (positional_tail)
+        {
+            positional_tail->valid              = true;
+            positional_tail->max_elements       = limits.max_list_elements;
+            positional_tail->max_range_elements = limits.max_range_elements;
+            positional_tail->pool               = pool.get();
+        }
 
-        if (arguments.empty()) return;
+        update_layout();
 
-        const auto& first_arg = arguments.front();
+        // Names are never removed, so the sorted array only has to be rebuilt when names were added.
+        if (abbreviations && long_names.size() != flags_long.size() + values_long.size() + lists_long.size())
+        {
+            long_names.clear();
+            for (const auto& [k, v] : flags_long) long_names.emplace_back(k);
+            for (const auto& [k, v] : values_long) long_names.emplace_back(k);
+            for (const auto& [k, v] : lists_long) long_names.emplace_back(k);
+            std::ranges::sort(long_names);
+        }
+    }
 
-        if (first_arg == "-v"s || first_arg == "--version"s || first_arg == "version"s)
+    void parser::update_layout()
+    {
+        // Arguments are never removed, so the layout only changes when arguments were added.
+        if (layout_size == argument_objects.size()) return;
+
+        // Results and checkpoints restore the state of each argument with a static_cast, so the type is part of the
+        // layout as well as the name.
+        fingerprint_hasher hasher;
+        hasher.add(static_cast<uint64_t>(argument_objects.size()));
+        for (const auto& arg : argument_objects)
         {
-            requested_version = true;
-            return;
+            hasher.add(std::string_view(arg->get_pretty_name()));
+            hasher.add(std::string_view(typeid(*arg).name()));
         }
+        layout      = hasher.digest();
+        layout_size = argument_objects.size();
+    }
 
-        if (first_arg == "-h"s || first_arg == "--help"s || first_arg == "help"s)
+    void parser::check_dependencies(const base_value& v) const
+    {
+        // Another parser would run at a different time, if at all, so its values cannot be derived from.
+        for (const auto* d : v.dependencies)
         {
-            requested_help = true;
-            return;
+            if (d->index >= argument_objects.size() || argument_objects[d->index].get() != d)
+                throw_exception(std::format("The default of {0} depends on {1}, which belongs to another parser",
+                                            v.get_pretty_name(),
+                                            d->get_pretty_name()));
         }
+    }
 
-        value_ptr active_value = nullptr;
-        list_ptr  active_list  = nullptr;
+    bool parser::step(const std::string& arg)
+    {
+        if (stopped || requested_version || requested_help) return false;
 
-        for (const auto& arg : arguments)
+        // Enforce limits before doing anything with the argument.
+        if (token_count == limits.max_arguments)
+        {
+            stop(parse_error::too_many_arguments,
+                 arg,
+                 std::format("number of arguments exceeds the maximum of {0}", limits.max_arguments));
+            return false;
+        }
+        if (arg.size() > limits.max_argument_length)
         {
-            auto short_name = false;
-            auto long_name  = false;
+            stop(parse_error::argument_too_long,
+                 arg,
+                 std::format("argument length exceeds the maximum of {0}", limits.max_argument_length));
+            return false;
+        }
+        if (arg.size() > limits.max_total_length - total_length)
+        {
+            stop(parse_error::input_too_large,
+                 arg,
+                 std::format("total length of arguments exceeds the maximum of {0}", limits.max_total_length));
+            return false;
+        }
+        total_length += arg.size();
 
-            // Arguments starting with a single '-' are short names.
-            // Arguments starting with a double '--' are long names.
-            if (arg[0] == '-')
+        process(arg);
+        check_errors(arg);
+
+        return !stopped && !requested_version && !requested_help;
+    }
+
+    void parser::process(const std::string& arg)
+    {
+        // Version and help are only recognized as the first argument.
+        if (token_count++ == 0)
+        {
+            if (arg == "-v"s || arg == "--version"s || arg == "version"s)
             {
-                active_value.reset();
-                active_list.reset();
+                requested_version = true;
+                return;
+            }
 
-                if (arg.size() == 1)
-                {
-                    parse_errors.emplace_back(
-                      parse_error::invalid_short_name, arg, "single '-' character without short name"s);
-                    continue;
-                }
+            if (arg == "-h"s || arg == "--help"s || arg == "help"s)
+            {
+                requested_help = true;
+                return;
+            }
+        }
+
+        auto short_name = false;
+        auto long_name  = false;
+
+        // Arguments starting with a single '-' are short names.
+        // Arguments starting with a double '--' are long names.
+        if (arg[0] == '-')
+        {
+            if (active_list) complete(*active_list);
+            active_value.reset();
+            active_list.reset();
+
+            if (arg.size() == 1)
+            {
+                parse_errors.emplace_back(
+                  parse_error::invalid_short_name, arg, "single '-' character without short name"s);
+                return;
+            }
 
-                if (arg[1] == '-')
+            if (arg[1] == '-')
+            {
+                if (arg.size() < 4)
                 {
-                    if (arg.size() < 4)
-                    {
-                        parse_errors.emplace_back(
-                          parse_error::invalid_long_name, arg, "long name should be at least 2 characters long"s);
-                        continue;
-                    }
-                    long_name = true;
+                    parse_errors.emplace_back(
+                      parse_error::invalid_long_name, arg, "long name should be at least 2 characters long"s);
+                    return;
                 }
-                else
-                    short_name = true;
+                long_name = true;
             }
-            // Other arguments are values.
             else
+                short_name = true;
+        }
+        // Other arguments are values.
+        else
+        {
+            // Previous argument was a value, try to parse.
+            if (active_value)
             {
-                // Previous argument was a value, try to parse.
-                if (active_value)
-                {
-                    active_value->parse(arg, parse_errors);
-                    active_value.reset();
-                }
-                // Previous argument was a list, try to parse.
-                else if (active_list)
-                    active_list->parse(arg, parse_errors);
-                // Collect operands.
-                else
-                    operands.push_back(arg);
-                continue;
+                parse_argument(*active_value, arg);
+                complete(*active_value);
+                active_value.reset();
+            }
+            // Previous argument was a list, try to parse.
+            else if (active_list)
+                parse_argument(*active_list, arg);
+            // Convert operands by position.
+            else if (positional_count < positionals.size())
+            {
+                const auto& positional = positionals[positional_count++];
+                parse_argument(*positional, arg);
+                complete(*positional);
+            }
+            else if (positional_tail)
+                parse_argument(*positional_tail, arg);
+            // Collect operands.
+            else if (operands.size() < limits.max_operands)
+            {
+                operand_hasher.add(std::string_view(arg));
+                operands.push_back(arg);
             }
+            else
+                stop(parse_error::too_many_operands,
+                     arg,
+                     std::format("number of operands exceeds the maximum of {0}", limits.max_operands));
+            return;
+        }
+
+        if (short_name)
+            parse_short_name(arg);
+        else if (long_name)
+            parse_long_name(arg);
+    }
 
-            if (short_name)
-                parse_short_name(arg, active_value, active_list);
-            else if (long_name)
-                parse_long_name(arg, active_value, active_list);
+    void parser::end()
+    {
+        if (active_list) complete(*active_list);
+        if (positional_tail && positional_tail->has_value()) complete(*positional_tail);
+        active_value.reset();
+        active_list.reset();
+
+        // The environment and constraints are meaningless when parsing was cut short. Their errors count towards the
+        // maximum number of errors like those of the arguments.
+        if (!stopped && !requested_version && !requested_help)
+        {
+            parse_env();
+            check_errors(""s);
+            for (const auto& arg : argument_objects)
+            {
+                if (stopped) break;
+                arg->validate(parse_errors);
+                check_errors(""s);
+            }
+            if (!stopped)
+            {
+                argument_constraints.check(argument_objects, parse_errors);
+                check_errors(""s);
+            }
+        }
+
+        record();
+    }
+
+    template<typename A>
+    void parser::parse_argument(A& arg, const std::string& str)
+    {
+        if (telemetry_sink) observations.emplace_back(arg.index, str);
+        arg.parse(str, parse_errors);
+    }
+
+    void parser::record()
+    {
+        if (telemetry_sink) telemetry_sink->record(argument_objects, parse_errors, observations);
+        if (batch_sink) batch_sink->append(operands);
+        if (recording_sink) recording_sink->record(arguments, argument_objects, parse_errors);
+    }
+
+    void parser::stop(const parse_error error, const std::string& arg, std::string message)
+    {
+        parse_errors.emplace_back(error, arg.substr(0, limits.max_argument_length), std::move(message));
+        stopped = true;
+    }
+
+    void parser::check_errors(const std::string& arg)
+    {
+        if (stopped || parse_errors.size() < limits.max_errors) return;
+        stop(parse_error::too_many_errors,
+             arg,
+             std::format("number of errors reached the maximum of {0}", limits.max_errors));
+    }
+
+    void parser::complete(argument& arg)
+    {
+        if (arg.has_value()) arg.source = value_source::command_line;
+        update_fingerprint(arg);
+        if (on_complete) on_complete(arg);
+    }
+
+    void parser::update_fingerprint(argument& arg)
+    {
+        if (!arg.fingerprinted) return;
+
+        fingerprint_sum -= arg.contribution;
+        arg.contribution = {};
+        if (!arg.has_value()) return;
+
+        // Combine the identity of the argument with its value.
+        fingerprint_hasher hasher;
+        hasher.add(static_cast<uint64_t>(static_cast<unsigned char>(arg.short_name)));
+        hasher.add(std::string_view(arg.long_name));
+        const auto digest = arg.get_fingerprint();
+        hasher.add(digest.low);
+        hasher.add(digest.high);
+        arg.contribution = hasher.digest();
+        fingerprint_sum += arg.contribution;
+    }
+
+    void parser::parse_env()
+    {
+        // Collect the names of all bound arguments that were not passed on the command line.
+        name_map<argument*> bound;
+        for (const auto& arg : argument_objects)
+        {
+            if (arg->positional || arg->has_value()) continue;
+
+            if (!arg->env_name.empty())
+                bound.emplace(arg->env_name, arg.get());
+            else if (!env_prefix.empty() && !arg->long_name.empty())
+            {
+                std::string name;
+                name.reserve(env_prefix.size() + arg->long_name.size());
+                name.append(env_prefix);
+                for (const auto c : arg->long_name)
+                    name.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+                bound.emplace(std::move(name), arg.get());
+            }
+        }
+
+        if (bound.empty()) return;
+
+#ifdef WIN32
+        char** env = _environ;
+#else
+        char** env = environ;
+#endif
+
+        for (; env && *env; ++env)
+        {
+            const std::string_view var(*env);
+            const auto             equals = var.find('=');
+            if (equals == std::string_view::npos) continue;
+
+            const auto it = bound.find(var.substr(0, equals));
+            if (it == bound.end()) continue;
+
+            auto& arg = *it->second;
+            std::string value(var.substr(equals + 1));
+            if (telemetry_sink) observations.emplace_back(arg.index, value);
+            if (cache) environment.emplace_back(it->first, value);
+            arg.parse_env(value, parse_errors);
+            if (arg.has_value()) arg.source = value_source::environment;
+            update_fingerprint(arg);
+
+            // Like getenv, only use the first definition of a variable.
+            bound.erase(it);
+        }
+
+        // A cached result is only valid while the same variables have the same values, or are still not set.
+        if (cache)
+        {
+            for (const auto& [name, arg] : bound) environment.emplace_back(name, std::nullopt);
+            std::ranges::sort(environment);
+        }
+    }
+
+    parse_result_ptr parser::save() const
+    {
+        auto r               = std::make_shared<parse_result>();
+        r->arguments         = arguments;
+        r->operands          = operands;
+        r->parse_errors      = parse_errors;
+        r->requested_version = requested_version;
+        r->requested_help    = requested_help;
+        r->observations      = observations;
+        r->environment       = environment;
+        r->layout            = layout;
+        r->states.reserve(argument_objects.size());
+        r->sources.reserve(argument_objects.size());
+        for (const auto& arg : argument_objects)
+        {
+            r->states.emplace_back(arg->save());
+            r->sources.emplace_back(arg->source);
+        }
+        return r;
+    }
+
+    void parser::restore(const parse_result& r)
+    {
+        if (r.layout != layout) throw_exception("Cannot restore a result of a parser with different arguments"s);
+
+        operands          = r.operands;
+        parse_errors      = r.parse_errors;
+        requested_version = r.requested_version;
+        requested_help    = r.requested_help;
+        observations      = r.observations;
+        environment       = r.environment;
+        fingerprint_sum   = {};
+        operand_hasher    = {};
+        for (const auto& operand : operands) operand_hasher.add(std::string_view(operand));
+        for (size_t i = 0; i < argument_objects.size(); i++)
+        {
+            argument_objects[i]->restore(*r.states[i]);
+            argument_objects[i]->source       = r.sources[i];
+            argument_objects[i]->contribution = {};
+            update_fingerprint(*argument_objects[i]);
+        }
+    }
+
+    void parser::restore(const parse_checkpoint& checkpoint)
+    {
+        restore(*checkpoint.state);
+
+        positional_count = checkpoint.positional_count;
+        token_count      = checkpoint.token_count;
+        total_length     = checkpoint.total_length;
+        stopped          = checkpoint.stopped;
+
+        active_value.reset();
+        active_list.reset();
+        if (checkpoint.active_value != parse_checkpoint::npos)
+        {
+            active_value = std::dynamic_pointer_cast<base_value>(argument_objects[checkpoint.active_value]);
+            if (!active_value) throw_exception("Cannot resume from a checkpoint of a parser with different arguments"s);
+        }
+        if (checkpoint.active_list != parse_checkpoint::npos)
+        {
+            active_list = std::dynamic_pointer_cast<base_list>(argument_objects[checkpoint.active_list]);
+            if (!active_list) throw_exception("Cannot resume from a checkpoint of a parser with different arguments"s);
         }
     }
 
@@ -394,11 +994,11 @@ namespace pt
         {
             // Verify short name is an alphabetic character.
             if (!std::isalpha(static_cast<unsigned char>(short_name)))
-                throw parser_tongue_exception("The short name should be an alphabetic character"s);
+                throw_exception("The short name should be an alphabetic character"s);
 
             // Verify none of the reserved characters are used.
             if (short_name == 'v' || short_name == 'h')
-                throw parser_tongue_exception("The short name should not be one of the reserved characters v and h"s);
+                throw_exception("The short name should not be one of the reserved characters v and h"s);
 
             use_short_name = true;
         }
@@ -407,36 +1007,67 @@ namespace pt
         {
             // Verify length > 1.
             if (long_name.size() == 1)
-                throw parser_tongue_exception("The long name should be at least 2 characters long"s);
+                throw_exception("The long name should be at least 2 characters long"s);
 
             // Verify first character is alphabetic.
             if (!std::isalpha(static_cast<unsigned char>(long_name[0])))
-                throw parser_tongue_exception("The first character of a long name should be an alphabetic character"s);
+                throw_exception("The first character of a long name should be an alphabetic character"s);
 
             // Verify remaining characters are alphabetic or _.
             if (!std::all_of(long_name.begin() + 1, long_name.end(), [](const char c) {
                     return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
                 }))
-                throw parser_tongue_exception("A long name should consist of alphabetic characters and _"s);
+                throw_exception("A long name should consist of alphabetic characters and _"s);
 
             if (long_name == "version" || long_name == "help")
-                throw parser_tongue_exception(
+                throw_exception(
                   "The long name should not be one of the reserved names version and help"s);
 
             use_long_name = true;
         }
 
-        if (!use_short_name && !use_long_name) throw parser_tongue_exception("Must pass at least one name"s);
+        if (!use_short_name && !use_long_name) throw_exception("Must pass at least one name"s);
 
         // Check if names are in use.
         if (use_short_name && (flags.contains(short_name) || values.contains(short_name) || lists.contains(short_name)))
-            throw parser_tongue_exception("The short name is already in use"s);
+            throw_exception("The short name is already in use"s);
         if (use_long_name &&
             (flags_long.contains(long_name) || values_long.contains(long_name) || lists_long.contains(long_name)))
-            throw parser_tongue_exception("The long name is already in use"s);
+            throw_exception("The long name is already in use"s);
+    }
+
+    void parser::check_operand(const std::string& name) const
+    {
+        if (parsed) throw_exception("Cannot add operand after running the parser"s);
+        if (name.empty()) throw_exception("The name of an operand should not be empty"s);
+        if (positional_tail) throw_exception("Cannot add operand after the list of operands"s);
     }
 
-    void parser::parse_short_name(const std::string& arg, value_ptr& active_value, list_ptr& active_list)
+    void parser::add_constraint(const constraints::type         type,
+                                const argument_ptr&             trigger,
+                                const std::vector<argument_ptr>& args)
+    {
+        if (parsed) throw_exception("Cannot add constraint after running the parser"s);
+
+        const auto owned = [this](const argument_ptr& arg) {
+            return arg && arg->index < argument_objects.size() && argument_objects[arg->index] == arg;
+        };
+
+        if (type == constraints::type::dependency && !owned(trigger))
+            throw_exception("The trigger argument does not belong to this parser"s);
+
+        std::vector<const argument*> ptrs;
+        ptrs.reserve(args.size());
+        for (const auto& arg : args)
+        {
+            if (!owned(arg)) throw_exception("The constrained argument does not belong to this parser"s);
+            ptrs.push_back(arg.get());
+        }
+
+        argument_constraints.add(type, trigger.get(), ptrs);
+    }
+
+    void parser::parse_short_name(const std::string& arg)
     {
         // Argument is just a short name.
         if (arg.size() == 2)
@@ -451,7 +1082,8 @@ namespace pt
             // Try to find flag.
             if (const auto it = flags.find(arg[1]); it != flags.end())
             {
-                it->second->value = true;
+                it->second->set(true);
+                complete(*it->second);
                 return;
             }
 
@@ -495,14 +1127,16 @@ namespace pt
                 // Try to find value.
                 if (const auto it = values.find(arg[1]); it != values.end())
                 {
-                    it->second->parse(arg.substr(3, arg.size() - 3), parse_errors);
+                    parse_argument(*it->second, arg.substr(3, arg.size() - 3));
+                    complete(*it->second);
                     return;
                 }
 
                 // Try to find list.
                 if (const auto it = lists.find(arg[1]); it != lists.end())
                 {
-                    it->second->parse(arg.substr(3, arg.size() - 3), parse_errors);
+                    parse_argument(*it->second, arg.substr(3, arg.size() - 3));
+                    complete(*it->second);
                     return;
                 }
 
@@ -511,30 +1145,43 @@ namespace pt
                 return;
             }
 
-            // Argument is a list of flags.
+            // Argument is a list of flags. Invalid and unknown names are collected (each character once) and reported
+            // in a single error per kind, so that the cost of a long cluster stays linear in its length.
+            std::array<bool, 256> seen{};
+            std::string           invalid;
+            std::string           unknown;
             for (size_t i = 1; i < arg.size(); i++)
             {
-                if (!std::isalpha(static_cast<unsigned char>(arg[i])))
-                {
-                    parse_errors.emplace_back(
-                      parse_error::invalid_short_name, arg, "short name should be an alphabetic character"s);
-                    continue;
-                }
-
                 // Enable flag.
                 if (auto it = flags.find(arg[i]); it != flags.end())
                 {
-                    it->second->value = true;
+                    it->second->set(true);
+                    complete(*it->second);
                     continue;
                 }
 
-                parse_errors.emplace_back(
-                  parse_error::unknown_short_name, arg, "unknown short name "s + std::string(1, arg[i]));
+                auto& s = seen[static_cast<unsigned char>(arg[i])];
+                if (s) continue;
+                s = true;
+
+                if (!std::isalpha(static_cast<unsigned char>(arg[i])))
+                    invalid.push_back(arg[i]);
+                else
+                    unknown.push_back(arg[i]);
             }
+
+            if (!invalid.empty())
+                parse_errors.emplace_back(
+                  parse_error::invalid_short_name, arg, "short name should be an alphabetic character: "s + invalid);
+            if (!unknown.empty())
+                parse_errors.emplace_back(parse_error::unknown_short_name,
+                                          arg,
+                                          (unknown.size() == 1 ? "unknown short name "s : "unknown short names "s) +
+                                            unknown);
         }
     }
 
-    void parser::parse_long_name(const std::string& arg, value_ptr& active_value, list_ptr& active_list)
+    void parser::parse_long_name(const std::string& arg)
     {
         if (!std::isalpha(static_cast<unsigned char>(arg[2])))
         {
@@ -543,80 +1190,111 @@ namespace pt
             return;
         }
 
-        // Argument is value or list followed directly by its value(s).
-        if (const auto equals = arg.find_first_of('='); equals != std::string::npos)
+        // Find the end of the name and validate its characters in a single pass.
+        size_t equals = 3;
+        for (; equals < arg.size() && arg[equals] != '='; equals++)
         {
-            if (!std::all_of(arg.begin() + 3,
-                             arg.begin() + static_cast<std::make_signed_t<size_t>>(equals),
-                             [](const char c) { return std::isalpha(static_cast<unsigned char>(c)) || c == '_'; }))
+            if (!std::isalpha(static_cast<unsigned char>(arg[equals])) && arg[equals] != '_')
             {
                 parse_errors.emplace_back(parse_error::invalid_long_name,
                                           arg,
                                           "long name should consist of alphabetic and underscore characters"s);
                 return;
             }
+        }
+
+        const auto long_name = std::string_view(arg).substr(2, equals - 2);
+
+        // Expand an abbreviation to the full name once, so that the lookups below see the name that was meant.
+        auto name = long_name;
+        if (abbreviations && !flags_long.contains(name) && !values_long.contains(name) && !lists_long.contains(name))
+        {
+            const auto [first, last] = find_abbreviation(name);
+            if (last - first > 1)
+            {
+                // List a bounded number of candidates, so that a short argument cannot produce a huge message.
+                constexpr std::ptrdiff_t max_candidates = 8;
+                auto message = "ambiguous long name "s.append(long_name).append(", candidates:"s);
+                for (auto it = first; it != last && it - first < max_candidates; ++it) message.append(" "s).append(*it);
+                if (last - first > max_candidates)
+                    message.append(std::format(" and {0} more", last - first - max_candidates));
+                parse_errors.emplace_back(parse_error::ambiguous_long_name, arg, std::move(message));
+                return;
+            }
+            if (first != last) name = *first;
+        }
 
+        // Argument is value or list followed directly by its value(s).
+        if (equals != arg.size())
+        {
             if (equals == arg.size() - 1)
             {
                 parse_errors.emplace_back(parse_error::missing_value, arg, "missing values after = character"s);
                 return;
             }
 
-            const auto long_name = arg.substr(2, equals - 2);
-
             // Try to find value.
-            if (const auto it = values_long.find(long_name); it != values_long.end())
+            if (const auto it = values_long.find(name); it != values_long.end())
             {
-                it->second->parse(arg.substr(equals + 1, arg.size() - equals - 1), parse_errors);
+                parse_argument(*it->second, arg.substr(equals + 1, arg.size() - equals - 1));
+                complete(*it->second);
                 return;
             }
 
             // Try to find list.
-            if (const auto it = lists_long.find(long_name); it != lists_long.end())
+            if (const auto it = lists_long.find(name); it != lists_long.end())
             {
-                it->second->parse(arg.substr(equals + 1, arg.size() - equals - 1), parse_errors);
+                parse_argument(*it->second, arg.substr(equals + 1, arg.size() - equals - 1));
+                complete(*it->second);
                 return;
             }
 
-            parse_errors.emplace_back(parse_error::unknown_long_name, arg, "unknown long name "s + long_name);
-        }
-        // Argument can be flag, value or list.
-        else
-        {
-            if (!std::all_of(arg.begin() + 3, arg.end(), [](const char c) {
-                    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
-                }))
+            // Flags do not take values.
+            if (const auto it = flags_long.find(name); it != flags_long.end())
             {
-                parse_errors.emplace_back(parse_error::invalid_long_name,
+                parse_errors.emplace_back(parse_error::parsing_error,
                                           arg,
-                                          "long name should consist of alphabetic and underscore characters"s);
+                                          std::format("{0} does not take a value", it->second->get_pretty_name()));
                 return;
             }
-
-            const auto long_name = arg.substr(2, arg.size() - 2);
-
+        }
+        // Argument can be flag, value or list.
+        else
+        {
             // Try to find flag.
-            if (const auto it = flags_long.find(long_name); it != flags_long.end())
+            if (const auto it = flags_long.find(name); it != flags_long.end())
             {
-                it->second->value = true;
+                it->second->set(true);
+                complete(*it->second);
                 return;
             }
 
             // Try to find value.
-            if (const auto it = values_long.find(long_name); it != values_long.end())
+            if (const auto it = values_long.find(name); it != values_long.end())
             {
                 active_value = it->second;
                 return;
             }
 
             // Try to find list.
-            if (const auto it = lists_long.find(long_name); it != lists_long.end())
+            if (const auto it = lists_long.find(name); it != lists_long.end())
             {
                 active_list = it->second;
                 return;
             }
-
-            parse_errors.emplace_back(parse_error::unknown_long_name, arg, "unknown long name "s + long_name);
         }
+
+        parse_errors.emplace_back(parse_error::unknown_long_name, arg, "unknown long name "s.append(long_name));
+    }
+
+    std::pair<std::vector<std::string_view>::const_iterator, std::vector<std::string_view>::const_iterator>
+      parser::find_abbreviation(const std::string_view prefix) const
+    {
+        // All names starting with the prefix form a contiguous range in the sorted array. Both ends are found by a
+        // binary search, so that the cost does not depend on the number of matching names.
+        const auto first = std::ranges::lower_bound(long_names, prefix);
+        const auto last  = std::partition_point(
+          first, long_names.end(), [prefix](const std::string_view name) { return name.starts_with(prefix); });
+        return {first, last};
     }
 }  // namespace pt
@@ -1,8 +1,25 @@
 #include "parsertongue/parser_tongue_exception.h"
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+
 namespace pt
 {
     parser_tongue_exception::parser_tongue_exception(std::string message) : message(std::move(message)) {}
 
     char const* parser_tongue_exception::what() const noexcept { return message.c_str(); }
+
+    void throw_exception(std::string message)
+    {
+#if PARSERTONGUE_EXCEPTIONS
+        throw parser_tongue_exception(std::move(message));
+#else
+        std::fprintf(stderr, "parsertongue: %s\n", message.c_str());
+        std::abort();
+#endif
+    }
 }  // namespace pt
@@ -0,0 +1,130 @@
+#include "parsertongue/push_parser.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cctype>
+
+using namespace std::string_literals;
+
+namespace pt
+{
+    push_parser::push_parser(parser& p) : target(p)
+    {
+        if (target.parsed) throw_exception("Cannot push to a parser that was already run"s);
+        target.parsed = true;
+        target.begin();
+
+        for (const auto& arg : target.arguments)
+        {
+            if (!target.step(arg)) break;
+        }
+    }
+
+    void push_parser::set_callback(std::function<void(const argument&)> callback)
+    {
+        target.on_complete = std::move(callback);
+    }
+
+    bool push_parser::feed(const std::string_view bytes, std::string& error)
+    {
+        if (finished) throw_exception("Cannot feed a push parser after finishing"s);
+
+        return detail::guard(
+          [&] {
+              for (const auto c : bytes)
+              {
+                  if (is_stopped()) break;
+
+                  if (escape)
+                  {
+                      append(c);
+                      escape = false;
+                  }
+                  else if (c == '\\' && quote != '\'')
+                  {
+                      escape   = true;
+                      in_token = true;
+                  }
+                  else if (quote != '\0')
+                  {
+                      if (c == quote)
+                          quote = '\0';
+                      else
+                          append(c);
+                  }
+                  else if (c == '\'' || c == '"')
+                  {
+                      quote    = c;
+                      in_token = true;
+                  }
+                  else if (std::isspace(static_cast<unsigned char>(c)))
+                  {
+                      if (in_token) push(std::move(token));
+                  }
+                  else
+                  {
+                      append(c);
+                      in_token = true;
+                  }
+              }
+              return true;
+          },
+          error);
+    }
+
+    bool push_parser::feed_argument(std::string arg, std::string& error)
+    {
+        if (finished) throw_exception("Cannot feed a push parser after finishing"s);
+
+        return detail::guard(
+          [&] {
+              push(std::move(arg));
+              return true;
+          },
+          error);
+    }
+
+    bool push_parser::finish(std::string& error)
+    {
+        if (finished) throw_exception("Cannot finish a push parser multiple times"s);
+        finished = true;
+
+        return detail::guard(
+          [&] {
+              // An unterminated quote still results in an argument, so that as much as possible is parsed.
+              if (quote != '\0' && !is_stopped())
+                  target.parse_errors.emplace_back(parse_error::unterminated_quote, token, "missing closing quote"s);
+              if (in_token || escape) push(std::move(token));
+              target.end();
+              return true;
+          },
+          error);
+    }
+
+    bool push_parser::is_finished() const noexcept { return finished; }
+
+    bool push_parser::is_stopped() const noexcept
+    {
+        return target.stopped || target.requested_version || target.requested_help;
+    }
+
+    void push_parser::append(const char c)
+    {
+        // Keep at most one character more than the maximum length, which is enough for the parser to report it.
+        if (token.size() <= target.limits.max_argument_length) token.push_back(c);
+    }
+
+    void push_parser::push(std::string arg)
+    {
+        token.clear();
+        in_token = false;
+        escape   = false;
+        quote    = '\0';
+
+        if (is_stopped()) return;
+        target.arguments.emplace_back(std::move(arg));
+        target.step(target.arguments.back());
+    }
+}  // namespace pt
@@ -0,0 +1,474 @@
+#include "parsertongue/recorder.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <string_view>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "parsertongue/parser.h"
+
+namespace pt
+{
+    using namespace std::string_literals;
+
+    namespace
+    {
+        // File layout: magic, format version and the layout of the parser, followed by records. Each record is the
+        // varint length of its payload and the payload: the number of arguments, each argument as a varint length
+        // and its bytes, the number of errors and their kinds, and the number of used arguments and the deltas
+        // between their indices.
+        constexpr std::string_view magic          = "PTRL";
+        constexpr char             version        = 1;
+        constexpr size_t           header_size    = 4 + 1 + 16;
+        constexpr size_t           maximum_varint = 10;
+
+        /**
+         * \brief Records are written once this many bytes are buffered.
+         */
+        constexpr size_t block_size = 64 * 1024;
+
+        void put_varint(std::string& out, uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                out.push_back(static_cast<char>(v | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<char>(v));
+        }
+
+        bool get_varint(const std::string_view in, size_t& pos, uint64_t& v) noexcept
+        {
+            v = 0;
+            for (size_t shift = 0; pos < in.size() && shift < 7 * maximum_varint; shift += 7)
+            {
+                const auto byte = static_cast<unsigned char>(in[pos++]);
+                v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        }
+
+        void put_word(std::string& out, const uint64_t v)
+        {
+            for (size_t i = 0; i < 8; i++) out.push_back(static_cast<char>(v >> (i * 8)));
+        }
+
+        uint64_t get_word(const std::string_view in) noexcept
+        {
+            uint64_t v = 0;
+            for (size_t i = 0; i < 8; i++) v |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (i * 8);
+            return v;
+        }
+
+        std::string make_header(const fingerprint& layout)
+        {
+            std::string header(magic);
+            header.push_back(version);
+            put_word(header, layout.low);
+            put_word(header, layout.high);
+            return header;
+        }
+
+        bool parse_header(const std::string_view header, fingerprint& layout) noexcept
+        {
+            if (header.size() < header_size || !header.starts_with(magic) || header[4] != version) return false;
+            layout = {.low = get_word(header.substr(5)), .high = get_word(header.substr(13))};
+            return true;
+        }
+
+        /**
+         * \brief Find the end of the last complete record.
+         */
+        size_t end_of_records(const std::string_view contents) noexcept
+        {
+            size_t pos = header_size;
+            while (pos < contents.size())
+            {
+                auto     next   = pos;
+                uint64_t length = 0;
+                if (!get_varint(contents, next, length) || length > contents.size() - next) break;
+                pos = next + static_cast<size_t>(length);
+            }
+            return pos;
+        }
+
+        bool read_file(const std::filesystem::path& path, std::string& contents)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) return false;
+            contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            return !file.bad();
+        }
+
+        /**
+         * \brief Decode the payload of a record.
+         */
+        bool decode(const std::string_view payload, recorded_parse& parse)
+        {
+            size_t   pos = 0;
+            uint64_t n   = 0;
+            if (!get_varint(payload, pos, n) || n > payload.size()) return false;
+            parse.arguments.reserve(static_cast<size_t>(n));
+            for (uint64_t i = 0; i < n; i++)
+            {
+                uint64_t length = 0;
+                if (!get_varint(payload, pos, length) || length > payload.size() - pos) return false;
+                parse.arguments.emplace_back(payload.substr(pos, static_cast<size_t>(length)));
+                pos += static_cast<size_t>(length);
+            }
+
+            if (!get_varint(payload, pos, n) || n > payload.size()) return false;
+            for (uint64_t i = 0; i < n; i++)
+            {
+                uint64_t kind = 0;
+                if (!get_varint(payload, pos, kind)) return false;
+                parse.errors.push_back(static_cast<parse_error>(kind));
+            }
+
+            if (!get_varint(payload, pos, n) || n > payload.size()) return false;
+            uint64_t index = 0;
+            for (uint64_t i = 0; i < n; i++)
+            {
+                uint64_t delta = 0;
+                if (!get_varint(payload, pos, delta)) return false;
+                index += delta;
+                parse.used.push_back(static_cast<uint32_t>(index));
+            }
+            return pos == payload.size();
+        }
+
+        /**
+         * \brief Scratch buffer for encoding records, so that encoding does not allocate in the steady state.
+         */
+        thread_local std::string scratch;
+    }  // namespace
+
+    ////////////////////////////////////////////////////////////////
+    // replay_report.
+    ////////////////////////////////////////////////////////////////
+
+    double replay_report::get_throughput() const noexcept
+    {
+        if (elapsed.count() <= 0) return 0;
+        return static_cast<double>(parses) / std::chrono::duration<double>(elapsed).count();
+    }
+
+    std::string replay_report::to_json() const
+    {
+        std::string out = std::format("{{\"parses\":{},\"elapsed_ns\":{},\"throughput\":{},\"latency_ns\":{{\"p50\":{},"
+                                      "\"p90\":{},\"p99\":{},\"max\":{}}},\"mismatches\":[",
+                                      parses,
+                                      elapsed.count(),
+                                      get_throughput(),
+                                      p50.count(),
+                                      p90.count(),
+                                      p99.count(),
+                                      max.count());
+        for (size_t i = 0; i < mismatches.size(); i++)
+        {
+            if (i > 0) out.push_back(',');
+            out.append(std::format("{}", mismatches[i]));
+        }
+        out.append("]}");
+        return out;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // recorder.
+    ////////////////////////////////////////////////////////////////
+
+    recorder::recorder(std::filesystem::path path, const uint64_t max_bytes, const uint64_t sample_every) :
+        path(std::move(path)), max_bytes(max_bytes), sample_every(sample_every)
+    {
+        if (sample_every == 0) throw_exception("The sampling interval must be at least 1"s);
+    }
+
+    recorder::~recorder() noexcept
+    {
+        std::scoped_lock lock(mutex);
+        std::string      error;
+        static_cast<void>(write(error));
+    }
+
+    bool recorder::open(std::string& error)
+    {
+        std::scoped_lock lock(mutex);
+        if (file.is_open()) throw_exception("The recorder is already open"s);
+
+        std::error_code ec;
+        auto            existing = std::filesystem::exists(path, ec) ? std::filesystem::file_size(path, ec) : 0;
+        if (ec)
+        {
+            error = std::format("Could not read {0}: {1}", path.string(), ec.message());
+            return false;
+        }
+
+        if (existing > 0)
+        {
+            std::string contents;
+            fingerprint file_layout;
+            if (!read_file(path, contents))
+            {
+                error = std::format("Could not read {0}", path.string());
+                return false;
+            }
+            if (!parse_header(contents, file_layout))
+            {
+                error = std::format("{0} is not a recording", path.string());
+                return false;
+            }
+            if (has_layout && file_layout != layout)
+            {
+                error = std::format("{0} was recorded by a parser with different arguments", path.string());
+                return false;
+            }
+            layout     = file_layout;
+            has_layout = true;
+
+            // Cut off a record that was only partially written, e.g. by a process that crashed, so that new records
+            // are not appended to it.
+            const auto end = end_of_records(contents);
+            if (end < existing)
+            {
+                std::filesystem::resize_file(path, end, ec);
+                if (ec)
+                {
+                    error = std::format("Could not truncate {0}: {1}", path.string(), ec.message());
+                    return false;
+                }
+                existing = end;
+            }
+        }
+
+        file.open(path, std::ios::binary | std::ios::app);
+        if (!file)
+        {
+            error = std::format("Could not open {0}", path.string());
+            return false;
+        }
+
+        size = existing;
+        accepting.store(size < max_bytes, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool recorder::flush(std::string& error)
+    {
+        std::scoped_lock lock(mutex);
+        if (!file.is_open())
+        {
+            error = "The recorder is not open"s;
+            return false;
+        }
+        return write(error);
+    }
+
+    uint64_t recorder::get_recorded() const noexcept { return recorded.load(std::memory_order_relaxed); }
+
+    uint64_t recorder::get_dropped() const noexcept { return dropped.load(std::memory_order_relaxed); }
+
+    const std::filesystem::path& recorder::get_path() const noexcept { return path; }
+
+    void recorder::attach(const std::vector<argument_ptr>& arguments)
+    {
+        const auto l = layout_of(arguments);
+
+        std::scoped_lock lock(mutex);
+        if (has_layout && l != layout) throw_exception("The recorder belongs to a parser with different arguments"s);
+        layout     = l;
+        has_layout = true;
+    }
+
+    void recorder::record(const std::vector<std::string>&   args,
+                          const std::vector<argument_ptr>&  arguments,
+                          const std::vector<parse_error_t>& errors)
+    {
+        if (sampled.fetch_add(1, std::memory_order_relaxed) % sample_every != 0) return;
+        if (!accepting.load(std::memory_order_relaxed))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Encode the payload without holding the lock.
+        auto& payload = scratch;
+        payload.clear();
+        put_varint(payload, args.size());
+        for (const auto& arg : args)
+        {
+            put_varint(payload, arg.size());
+            payload.append(arg);
+        }
+        put_varint(payload, errors.size());
+        for (const auto& e : errors) put_varint(payload, static_cast<uint64_t>(std::get<0>(e)));
+        size_t used = 0;
+        for (const auto& arg : arguments) used += arg->source == value_source::command_line;
+        put_varint(payload, used);
+        size_t previous = 0;
+        for (size_t i = 0; i < arguments.size(); i++)
+        {
+            if (arguments[i]->source != value_source::command_line) continue;
+            put_varint(payload, i - previous);
+            previous = i;
+        }
+
+        std::scoped_lock lock(mutex);
+        if (size == 0)
+        {
+            buffer.append(make_header(layout));
+            size = header_size;
+        }
+
+        // Short enough for the small string optimization.
+        std::string prefix;
+        put_varint(prefix, payload.size());
+        if (size + prefix.size() + payload.size() > max_bytes)
+        {
+            // Stop encoding further parses. Smaller records could still fit, but a full log is not worth the cost.
+            accepting.store(false, std::memory_order_relaxed);
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer.append(prefix);
+        buffer.append(payload);
+        size += prefix.size() + payload.size();
+        recorded.fetch_add(1, std::memory_order_relaxed);
+
+        if (buffer.size() >= block_size)
+        {
+            std::string error;
+            static_cast<void>(write(error));
+        }
+    }
+
+    bool recorder::write(std::string& error)
+    {
+        if (buffer.empty()) return true;
+        if (!file.is_open() || !file.write(buffer.data(), static_cast<std::streamsize>(buffer.size())) ||
+            !file.flush())
+        {
+            accepting.store(false, std::memory_order_relaxed);
+            error = std::format("Could not write {0}", path.string());
+            return false;
+        }
+        buffer.clear();
+        return true;
+    }
+
+    fingerprint recorder::layout_of(const std::vector<argument_ptr>& arguments)
+    {
+        fingerprint_hasher hasher;
+        hasher.add(static_cast<uint64_t>(arguments.size()));
+        for (const auto& arg : arguments) hasher.add(std::string_view(arg->get_pretty_name()));
+        return hasher.digest();
+    }
+
+    recorded_parse recorder::outcome_of(const std::vector<argument_ptr>&  arguments,
+                                        const std::vector<parse_error_t>& errors)
+    {
+        recorded_parse outcome;
+        outcome.errors.reserve(errors.size());
+        for (const auto& e : errors) outcome.errors.push_back(std::get<0>(e));
+        for (size_t i = 0; i < arguments.size(); i++)
+            if (arguments[i]->source == value_source::command_line) outcome.used.push_back(static_cast<uint32_t>(i));
+        return outcome;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Reading and replaying.
+    ////////////////////////////////////////////////////////////////
+
+    bool read_recording(const std::filesystem::path& path, recording& log, std::string& error)
+    {
+        std::string contents;
+        if (!read_file(path, contents))
+        {
+            error = std::format("Could not read {0}", path.string());
+            return false;
+        }
+
+        log = {};
+        if (!parse_header(contents, log.layout))
+        {
+            error = std::format("{0} is not a recording", path.string());
+            return false;
+        }
+
+        const std::string_view in(contents);
+        size_t                 pos = header_size;
+        while (pos < in.size())
+        {
+            const auto start  = pos;
+            uint64_t   length = 0;
+            if (!get_varint(in, pos, length) || length > in.size() - pos) break;
+
+            auto& parse = log.parses.emplace_back();
+            if (!decode(in.substr(pos, static_cast<size_t>(length)), parse))
+            {
+                error = std::format("{0} has a corrupt record at offset {1}", path.string(), start);
+                return false;
+            }
+            pos += static_cast<size_t>(length);
+        }
+        return true;
+    }
+
+    replay_report replay(parser& p, const recording& log, const size_t iterations)
+    {
+        if (p.recording_sink) throw_exception("Cannot replay into a parser with a recorder"s);
+        if (recorder::layout_of(p.argument_objects) != log.layout)
+            throw_exception("The recording was made by a parser with different arguments"s);
+
+        replay_report        report;
+        std::vector<int64_t> latencies;
+        latencies.reserve(log.parses.size() * iterations);
+        for (size_t it = 0; it < iterations; it++)
+        {
+            for (size_t i = 0; i < log.parses.size(); i++)
+            {
+                const auto& recorded = log.parses[i];
+                p.reset(recorded.arguments);
+
+                std::string error;
+                const auto  begin = std::chrono::steady_clock::now();
+                const auto  ok    = p(error);
+                const auto  end   = std::chrono::steady_clock::now();
+                latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+
+                if (it > 0) continue;
+                const auto outcome = recorder::outcome_of(p.argument_objects, p.parse_errors);
+                if (!ok || outcome.errors != recorded.errors || outcome.used != recorded.used)
+                    report.mismatches.push_back(i);
+            }
+        }
+
+        report.parses = latencies.size();
+        if (latencies.empty()) return report;
+
+        int64_t total = 0;
+        for (const auto l : latencies) total += l;
+        report.elapsed = std::chrono::nanoseconds(total);
+
+        // Nearest-rank percentiles.
+        std::ranges::sort(latencies);
+        const auto percentile = [&](const size_t q) {
+            const auto rank = (latencies.size() * q + 99) / 100;
+            return std::chrono::nanoseconds(latencies[std::max<size_t>(rank, 1) - 1]);
+        };
+        report.p50 = percentile(50);
+        report.p90 = percentile(90);
+        report.p99 = percentile(99);
+        report.max = std::chrono::nanoseconds(latencies.back());
+        return report;
+    }
+}  // namespace pt
@@ -0,0 +1,98 @@
+#include "parsertongue/string_pool.h"
+
+namespace pt
+{
+    namespace
+    {
+        const std::string empty_string;
+
+        constexpr size_t initial_capacity = 64;
+    }  // namespace
+
+    interned_string::interned_string() noexcept : s(&empty_string) {}
+
+    string_pool::table::table(const size_t capacity) :
+        mask(capacity - 1), slots(std::make_unique<std::atomic<const entry*>[]>(capacity))
+    {
+    }
+
+    string_pool::string_pool()
+    {
+        tables.emplace_back(std::make_unique<table>(initial_capacity));
+        current.store(tables.back().get(), std::memory_order_release);
+    }
+
+    string_pool::~string_pool() noexcept = default;
+
+    interned_string string_pool::intern(const std::string_view str)
+    {
+        if (str.empty()) return interned_string(&empty);
+
+        const auto hash = std::hash<std::string_view>{}(str);
+        if (const auto* e = lookup(*current.load(std::memory_order_acquire), str, hash))
+            return interned_string(&e->str);
+
+        std::scoped_lock lock(mutex);
+
+        // Another thread might have added the string in the meantime.
+        auto* t = current.load(std::memory_order_relaxed);
+        if (const auto* e = lookup(*t, str, hash)) return interned_string(&e->str);
+
+        // Keep the load factor at most 1/2. The new table is filled before it is published.
+        const auto n = count.load(std::memory_order_relaxed) + 1;
+        if (n * 2 > t->mask + 1)
+        {
+            auto bigger = std::make_unique<table>((t->mask + 1) * 2);
+            for (const auto& old : entries) insert(*bigger, old.get());
+            t = bigger.get();
+            tables.emplace_back(std::move(bigger));
+            current.store(t, std::memory_order_release);
+        }
+
+        const auto* e =
+          entries.emplace_back(std::make_unique<entry>(entry{.hash = hash, .str = std::string(str)})).get();
+        insert(*t, e);
+        count.store(n, std::memory_order_relaxed);
+        return interned_string(&e->str);
+    }
+
+    bool string_pool::find(const std::string_view str, interned_string& handle) const noexcept
+    {
+        if (str.empty())
+        {
+            handle = interned_string(&empty);
+            return true;
+        }
+
+        const auto* e = lookup(*current.load(std::memory_order_acquire), str, std::hash<std::string_view>{}(str));
+        if (!e) return false;
+        handle = interned_string(&e->str);
+        return true;
+    }
+
+    size_t string_pool::size() const noexcept { return count.load(std::memory_order_relaxed); }
+
+    string_pool& string_pool::global()
+    {
+        static string_pool pool;
+        return pool;
+    }
+
+    const string_pool::entry*
+      string_pool::lookup(const table& t, const std::string_view str, const size_t hash) noexcept
+    {
+        for (auto i = hash & t.mask;; i = (i + 1) & t.mask)
+        {
+            const auto* e = t.slots[i].load(std::memory_order_acquire);
+            if (!e) return nullptr;
+            if (e->hash == hash && e->str == str) return e;
+        }
+    }
+
+    void string_pool::insert(table& t, const entry* e) noexcept
+    {
+        auto i = e->hash & t.mask;
+        while (t.slots[i].load(std::memory_order_relaxed)) i = (i + 1) & t.mask;
+        t.slots[i].store(e, std::memory_order_release);
+    }
+}  // namespace pt
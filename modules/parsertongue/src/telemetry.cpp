@@ -0,0 +1,335 @@
+#include "parsertongue/telemetry.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <string_view>
+#include <unordered_map>
+
+namespace pt
+{
+    namespace
+    {
+        /**
+         * \brief Number of kinds of parse errors. Must be updated when kinds are added.
+         */
+        constexpr size_t error_kinds = static_cast<size_t>(parse_error::duplicate_key) + 1;
+
+        std::atomic<uint64_t> next_id = 0;
+
+        /**
+         * \brief Counter that is only written by a single thread, but can be read by any thread.
+         */
+        void increment(std::atomic<uint64_t>& counter) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        /**
+         * \brief Space-Saving sketch of the most frequent values: keeps at most capacity values, and replaces the
+         * least frequent one when a new value arrives, inheriting its count as error.
+         */
+        class space_saving
+        {
+        public:
+            explicit space_saving(const size_t capacity) : capacity(capacity) {}
+
+            void add(const std::string_view value)
+            {
+                if (capacity == 0) return;
+
+                if (const auto it = std::ranges::find(entries, value, &value_count::value); it != entries.end())
+                {
+                    it->count++;
+                    return;
+                }
+
+                if (entries.size() < capacity)
+                {
+                    entries.push_back({.value = std::string(value), .count = 1, .error = 0});
+                    return;
+                }
+
+                auto& min = *std::ranges::min_element(entries, {}, &value_count::count);
+                min.value = value;
+                min.error = min.count;
+                min.count++;
+            }
+
+            [[nodiscard]] const std::vector<value_count>& get_entries() const noexcept { return entries; }
+
+            /**
+             * \brief Get an upper bound of the count of values that are not in the sketch: the smallest count if values
+             * were evicted, otherwise 0.
+             */
+            [[nodiscard]] uint64_t get_floor() const noexcept
+            {
+                if (capacity == 0 || entries.size() < capacity) return 0;
+                return std::ranges::min_element(entries, {}, &value_count::count)->count;
+            }
+
+        private:
+            size_t                   capacity;
+            std::vector<value_count> entries;
+        };
+
+        /**
+         * \brief Sum of the counts and error bounds of a value over all shards whose sketch holds it.
+         */
+        struct merged_count
+        {
+            uint64_t count = 0;
+            uint64_t error = 0;
+
+            /**
+             * \brief Sum of the floors of the shards that were added.
+             */
+            uint64_t floor = 0;
+        };
+
+        struct local_entry
+        {
+            uint64_t id;
+            void*    shard;
+        };
+
+        /**
+         * \brief Shards of the calling thread, per sink. Entries of destroyed sinks are never matched again.
+         */
+        thread_local std::vector<local_entry> local_shards;
+
+        void append_json_string(std::string& out, const std::string_view str)
+        {
+            out.push_back('"');
+            for (const auto c : str)
+            {
+                switch (c)
+                {
+                case '"': out.append("\\\""); break;
+                case '\\': out.append("\\\\"); break;
+                case '\n': out.append("\\n"); break;
+                case '\r': out.append("\\r"); break;
+                case '\t': out.append("\\t"); break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        out.append(std::format("\\u{:04x}", static_cast<unsigned>(c)));
+                    else
+                        out.push_back(c);
+                }
+            }
+            out.push_back('"');
+        }
+
+        std::string_view error_name(const parse_error error)
+        {
+            switch (error)
+            {
+            case parse_error::invalid_short_name: return "invalid_short_name";
+            case parse_error::invalid_long_name: return "invalid_long_name";
+            case parse_error::unknown_short_name: return "unknown_short_name";
+            case parse_error::unknown_long_name: return "unknown_long_name";
+            case parse_error::missing_value: return "missing_value";
+            case parse_error::parsing_error: return "parsing_error";
+            case parse_error::unterminated_quote: return "unterminated_quote";
+            case parse_error::too_many_arguments: return "too_many_arguments";
+            case parse_error::argument_too_long: return "argument_too_long";
+            case parse_error::input_too_large: return "input_too_large";
+            case parse_error::too_many_operands: return "too_many_operands";
+            case parse_error::too_many_list_elements: return "too_many_list_elements";
+            case parse_error::too_many_errors: return "too_many_errors";
+            case parse_error::missing_required: return "missing_required";
+            case parse_error::missing_dependency: return "missing_dependency";
+            case parse_error::conflicting_arguments: return "conflicting_arguments";
+            case parse_error::missing_one_of: return "missing_one_of";
+            case parse_error::ambiguous_long_name: return "ambiguous_long_name";
+            case parse_error::validation_failed: return "validation_failed";
+            case parse_error::duplicate_key: return "duplicate_key";
+            }
+            return "unknown";
+        }
+    }  // namespace
+
+    struct telemetry::shard
+    {
+        shard(const size_t argument_count, const size_t top_k) :
+            argument_count(argument_count),
+            counters(std::make_unique<std::atomic<uint64_t>[]>(1 + error_kinds + argument_count * 2)),
+            sketches(argument_count, space_saving(top_k))
+        {
+        }
+
+        std::atomic<uint64_t>& parses() noexcept { return counters[0]; }
+
+        std::atomic<uint64_t>& errors(const size_t kind) noexcept { return counters[1 + kind]; }
+
+        std::atomic<uint64_t>& command_line(const size_t arg) noexcept { return counters[1 + error_kinds + arg * 2]; }
+
+        std::atomic<uint64_t>& environment(const size_t arg) noexcept
+        {
+            return counters[1 + error_kinds + arg * 2 + 1];
+        }
+
+        const size_t argument_count;
+
+        /**
+         * \brief Number of parses, errors per kind, and uses per argument and source. Only written by the owning
+         * thread.
+         */
+        std::unique_ptr<std::atomic<uint64_t>[]> counters;
+
+        /**
+         * \brief Protects the sketches against concurrent snapshots. Never contended by other recording threads.
+         */
+        std::mutex                mutex;
+        std::vector<space_saving> sketches;
+    };
+
+    telemetry::telemetry(const size_t top_k, const size_t max_value_length) :
+        id(next_id.fetch_add(1, std::memory_order_relaxed)), top_k(top_k), max_value_length(max_value_length)
+    {
+    }
+
+    telemetry::~telemetry() noexcept = default;
+
+    telemetry_snapshot telemetry::snapshot() const
+    {
+        telemetry_snapshot snap;
+        std::scoped_lock   lock(mutex);
+
+        snap.arguments.resize(names.size());
+        for (size_t i = 0; i < names.size(); i++) snap.arguments[i].name = names[i];
+
+        std::vector<uint64_t>                                      errors(error_kinds, 0);
+        std::vector<std::unordered_map<std::string, merged_count>> values(names.size());
+        std::vector<uint64_t>                                      floors(names.size(), 0);
+        for (const auto& s : shards)
+        {
+            snap.parses += s->parses().load(std::memory_order_relaxed);
+            for (size_t k = 0; k < error_kinds; k++) errors[k] += s->errors(k).load(std::memory_order_relaxed);
+
+            std::scoped_lock shard_lock(s->mutex);
+            for (size_t i = 0; i < std::min(s->argument_count, names.size()); i++)
+            {
+                snap.arguments[i].command_line += s->command_line(i).load(std::memory_order_relaxed);
+                snap.arguments[i].environment += s->environment(i).load(std::memory_order_relaxed);
+
+                // Merge the sketches by summing counts and error bounds. A shard that evicted values may have seen a
+                // value it no longer holds up to its floor times, which is added below.
+                const auto floor = s->sketches[i].get_floor();
+                floors[i] += floor;
+                for (const auto& e : s->sketches[i].get_entries())
+                {
+                    auto& merged = values[i][e.value];
+                    merged.count += e.count;
+                    merged.error += e.error;
+                    merged.floor += floor;
+                }
+            }
+        }
+
+        for (size_t k = 0; k < error_kinds; k++)
+            if (errors[k] > 0) snap.errors.emplace_back(static_cast<parse_error>(k), errors[k]);
+
+        for (size_t i = 0; i < names.size(); i++)
+        {
+            auto& top = snap.arguments[i].top_values;
+            top.reserve(values[i].size());
+            for (auto& [v, c] : values[i])
+            {
+                // Add the floors of the shards that do not hold the value to both the count and the error.
+                const auto missing = floors[i] - c.floor;
+                top.push_back({.value = v, .count = c.count + missing, .error = c.error + missing});
+            }
+            std::ranges::sort(top, [](const value_count& a, const value_count& b) {
+                return a.count != b.count ? a.count > b.count : a.value < b.value;
+            });
+            if (top.size() > top_k) top.resize(top_k);
+        }
+
+        return snap;
+    }
+
+    void telemetry::record(const std::vector<argument_ptr>&                    arguments,
+                           const std::vector<parse_error_t>&                   errors,
+                           const std::vector<std::pair<size_t, std::string>>& observations)
+    {
+        auto& s = local(arguments);
+
+        increment(s.parses());
+        for (const auto& e : errors)
+            if (const auto kind = static_cast<size_t>(std::get<0>(e)); kind < error_kinds) increment(s.errors(kind));
+
+        for (size_t i = 0; i < std::min(arguments.size(), s.argument_count); i++)
+        {
+            const auto source = arguments[i]->get_source();
+            if (source == value_source::command_line)
+                increment(s.command_line(i));
+            else if (source == value_source::environment)
+                increment(s.environment(i));
+        }
+
+        if (observations.empty()) return;
+
+        std::scoped_lock lock(s.mutex);
+        for (const auto& [index, value] : observations)
+        {
+            if (index >= s.argument_count) continue;
+            s.sketches[index].add(std::string_view(value).substr(0, max_value_length));
+        }
+    }
+
+    telemetry::shard& telemetry::local(const std::vector<argument_ptr>& arguments)
+    {
+        for (const auto& e : local_shards)
+            if (e.id == id) return *static_cast<shard*>(e.shard);
+
+        std::scoped_lock lock(mutex);
+
+        // The first parser to record determines the names of the arguments.
+        if (names.empty())
+        {
+            names.reserve(arguments.size());
+            for (const auto& arg : arguments) names.emplace_back(arg->get_pretty_name());
+        }
+
+        auto& s = *shards.emplace_back(std::make_unique<shard>(names.size(), top_k));
+        local_shards.push_back({.id = id, .shard = &s});
+        return s;
+    }
+
+    std::string telemetry_snapshot::to_json() const
+    {
+        std::string out = std::format("{{\"parses\":{},\"arguments\":[", parses);
+        for (size_t i = 0; i < arguments.size(); i++)
+        {
+            const auto& a = arguments[i];
+            if (i > 0) out.push_back(',');
+            out.append("{\"name\":");
+            append_json_string(out, a.name);
+            out.append(std::format(",\"command_line\":{},\"environment\":{},\"top_values\":[",
+                                   a.command_line,
+                                   a.environment));
+            for (size_t j = 0; j < a.top_values.size(); j++)
+            {
+                if (j > 0) out.push_back(',');
+                out.append("{\"value\":");
+                append_json_string(out, a.top_values[j].value);
+                out.append(std::format(",\"count\":{},\"error\":{}}}", a.top_values[j].count, a.top_values[j].error));
+            }
+            out.append("]}");
+        }
+        out.append("],\"errors\":{");
+        for (size_t i = 0; i < errors.size(); i++)
+        {
+            if (i > 0) out.push_back(',');
+            append_json_string(out, error_name(errors[i].first));
+            out.append(std::format(":{}", errors[i].second));
+        }
+        out.append("}}");
+        return out;
+    }
+}  // namespace pt
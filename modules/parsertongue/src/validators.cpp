@@ -0,0 +1,202 @@
+#include "parsertongue/validators.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <format>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace pt
+{
+    namespace
+    {
+        /**
+         * \brief Minimum number of paths per thread. Smaller batches are not worth handing to other threads.
+         */
+        constexpr size_t paths_per_thread = 8;
+
+        /**
+         * \brief Threads that are shared by all path validators, started on first use. Validating a list only hands
+         * out tasks to idle threads instead of starting and joining threads of its own.
+         */
+        class worker_pool
+        {
+        public:
+            explicit worker_pool(const size_t size)
+            {
+                workers.reserve(size);
+                for (size_t i = 0; i < size; i++)
+                    workers.emplace_back([this](const std::stop_token& stop) { work(stop); });
+            }
+
+            worker_pool(const worker_pool&) = delete;
+
+            worker_pool(worker_pool&&) = delete;
+
+            ~worker_pool() noexcept
+            {
+                for (auto& w : workers) w.request_stop();
+                available.notify_all();
+            }
+
+            worker_pool& operator=(const worker_pool&) = delete;
+
+            worker_pool& operator=(worker_pool&&) = delete;
+
+            [[nodiscard]] size_t size() const noexcept { return workers.size(); }
+
+            void submit(std::function<void()> task)
+            {
+                {
+                    std::scoped_lock lock(mutex);
+                    tasks.push_back(std::move(task));
+                }
+                available.notify_one();
+            }
+
+            /**
+             * \brief Get the pool. The calling thread takes part in the work, so it has one thread less than the
+             * hardware concurrency.
+             */
+            static worker_pool& get()
+            {
+                static worker_pool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+                return pool;
+            }
+
+        private:
+            void work(const std::stop_token& stop)
+            {
+                while (true)
+                {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock lock(mutex);
+                        if (!available.wait(lock, stop, [this] { return !tasks.empty(); })) return;
+                        task = std::move(tasks.front());
+                        tasks.pop_front();
+                    }
+                    task();
+                }
+            }
+
+            std::mutex                        mutex;
+            std::condition_variable_any       available;
+            std::deque<std::function<void()>> tasks;
+            std::vector<std::jthread>         workers;
+        };
+
+        /**
+         * \brief Helpers of a single validation that may still be queued in the pool after the validation finished.
+         */
+        struct helpers
+        {
+            std::mutex              mutex;
+            std::condition_variable idle;
+            size_t                  active = 0;
+            bool                    open   = true;
+        };
+
+        bool accessible(const std::filesystem::path& path, const bool write)
+        {
+#ifdef WIN32
+            return _waccess(path.c_str(), write ? 2 : 4) == 0;
+#else
+            return access(path.c_str(), write ? W_OK : R_OK) == 0;
+#endif
+        }
+    }  // namespace
+
+    path_validator::path_validator(const path_requirements requirements, const size_t threads) :
+        requirements(requirements), threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+    {
+    }
+
+    void path_validator::operator()(const std::span<const std::string> paths,
+                                    std::vector<validation_failure>&   failures) const
+    {
+        run(paths, failures);
+    }
+
+    void path_validator::operator()(const std::span<const std::filesystem::path> paths,
+                                    std::vector<validation_failure>&             failures) const
+    {
+        run(paths, failures);
+    }
+
+    std::string path_validator::check(const std::filesystem::path& path) const
+    {
+        std::error_code ec;
+        const auto      status = std::filesystem::status(path, ec);
+
+        if (!std::filesystem::exists(status))
+        {
+            if (requirements.exists || requirements.regular_file || requirements.directory || requirements.readable ||
+                requirements.writable)
+                return std::format("{0} does not exist", path.string());
+            return {};
+        }
+        if (requirements.regular_file && !std::filesystem::is_regular_file(status))
+            return std::format("{0} is not a regular file", path.string());
+        if (requirements.directory && !std::filesystem::is_directory(status))
+            return std::format("{0} is not a directory", path.string());
+        if (requirements.readable && !accessible(path, false))
+            return std::format("{0} is not readable", path.string());
+        if (requirements.writable && !accessible(path, true))
+            return std::format("{0} is not writable", path.string());
+        return {};
+    }
+
+    template<typename T>
+    void path_validator::run(const std::span<const T> paths, std::vector<validation_failure>& failures) const
+    {
+        // Each thread claims the next unchecked path, so that slow paths do not hold up the others.
+        std::vector<std::string> messages(paths.size());
+        std::atomic<size_t>      next = 0;
+        const auto               work = [&] {
+            for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < paths.size();
+                 i      = next.fetch_add(1, std::memory_order_relaxed))
+                messages[i] = check(paths[i]);
+        };
+
+        // Helpers that only start after all paths were claimed have nothing left to do, so they are not waited for.
+        auto&      pool  = worker_pool::get();
+        const auto count = std::min({threads, paths.size() / paths_per_thread, pool.size() + 1});
+        const auto state = std::make_shared<helpers>();
+        for (size_t i = 1; i < count; i++)
+        {
+            pool.submit([state, &work] {
+                {
+                    std::scoped_lock lock(state->mutex);
+                    if (!state->open) return;
+                    state->active++;
+                }
+                work();
+                std::scoped_lock lock(state->mutex);
+                if (--state->active == 0) state->idle.notify_all();
+            });
+        }
+        work();
+        {
+            std::unique_lock lock(state->mutex);
+            state->open = false;
+            state->idle.wait(lock, [&] { return state->active == 0; });
+        }
+
+        for (size_t i = 0; i < messages.size(); i++)
+            if (!messages[i].empty()) failures.push_back({.index = i, .message = std::move(messages[i])});
+    }
+}  // namespace pt
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "parsertongue/parser.h"
+
+namespace
+{
+    int failures = 0;
+
+    void check(const bool condition, const std::string& what)
+    {
+        if (condition) return;
+        std::cout << "FAILED: " << what << std::endl;
+        failures++;
+    }
+
+    /**
+     * \brief Parse the arguments with a parser that has a flag and a value whose names share a prefix.
+     */
+    void run(const std::vector<std::string>& args,
+             const bool                      abbreviations,
+             const pt::parse_error           expected_error,
+             const bool                      expected_flag)
+    {
+        auto parser = pt::parser(0, nullptr, true);
+        parser.set_abbreviations(abbreviations);
+        const auto verbose = parser.add_flag('\0', "verbose");
+        const auto level   = parser.add_value<int32_t>('\0', "level");
+        parser.reset(args);
+
+        const auto name = args.front() + (abbreviations ? " with abbreviations" : "");
+        std::string e;
+        check(parser(e), name + ": run");
+        check(parser.get_errors().size() == 1, name + ": one error");
+        if (!parser.get_errors().empty())
+            check(std::get<0>(parser.get_errors().front()) == expected_error, name + ": kind");
+        check(verbose->is_set() == expected_flag, name + ": flag");
+        check(!level->is_set(), name + ": value");
+    }
+
+    void run(const std::vector<std::string>& args, const bool abbreviations, const bool expected_flag)
+    {
+        auto parser = pt::parser(0, nullptr, true);
+        parser.set_abbreviations(abbreviations);
+        const auto verbose = parser.add_flag('\0', "verbose");
+        const auto verb    = parser.add_value<int32_t>('\0', "verb");
+        parser.reset(args);
+
+        const auto name = args.front() + (abbreviations ? " with abbreviations" : "");
+        std::string e;
+        check(parser(e), name + ": run");
+        check(parser.get_errors().empty(), name + ": no errors");
+        check(verbose->is_set() == expected_flag, name + ": flag");
+        check(verb->is_set() != expected_flag, name + ": value");
+    }
+}  // namespace
+
+int main()
+{
+    // A flag given a value is an error, whether its name is abbreviated or not.
+    for (const auto abbreviations : {false, true})
+    {
+        run({"--verbose=3"}, abbreviations, pt::parse_error::parsing_error, false);
+        run({"--verbose=3", "--verbose"}, abbreviations, pt::parse_error::parsing_error, true);
+    }
+    run({"--verb=3"}, false, pt::parse_error::unknown_long_name, false);
+    run({"--verb=3"}, true, pt::parse_error::parsing_error, false);
+    run({"--verbo=3"}, true, pt::parse_error::parsing_error, false);
+
+    // An exact name takes precedence over the longer names it abbreviates.
+    run({"--verb=3"}, true, false);
+    run({"--verb", "3"}, true, false);
+    run({"--verbo"}, true, true);
+
+    if (failures == 0) std::cout << "All tests passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
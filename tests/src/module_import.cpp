@@ -0,0 +1,44 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+import parsertongue;
+
+namespace
+{
+    int failures = 0;
+
+    void check(const bool condition, const std::string& what)
+    {
+        if (condition) return;
+        std::cout << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}  // namespace
+
+int main()
+{
+    // Only the module is imported, so everything used here must be exported by it.
+    auto       parser = pt::parser(0, nullptr, true);
+    const auto flag   = parser.add_flag('f', "flag");
+    const auto count  = parser.add_value<int32_t>('c', "count");
+    const auto names  = parser.add_list<std::string>('n', "names");
+    const auto ids    = parser.add_list<int64_t, pt::set_storage>('\0', "ids");
+    count->set_default(1);
+    parser.reset(std::vector<std::string>{"-f", "--names=a,b", "--ids=3,1-2,3"});
+
+    std::string e;
+    check(parser(e), "run");
+    check(parser.get_errors().empty(), "no errors");
+    check(flag->is_set(), "flag");
+    check(count->get_value() == 1, "default value");
+    check(names->get_values() == std::vector<std::string>{"a", "b"}, "list");
+    check(ids->get_values() == std::vector<int64_t>{1, 2, 3}, "set storage");
+
+    // Conversion errors must be nameable, not only returned.
+    const auto converted = pt::parse_value<int32_t>("x");
+    check(!converted && converted.error() == pt::conversion_error::invalid_value, "conversion error");
+
+    if (failures == 0) std::cout << "All tests passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
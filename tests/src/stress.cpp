@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "parsertongue/push_parser.h"
+
+////////////////////////////////////////////////////////////////
+// Allocation tracking. Every allocation carries its size in a
+// header, so that the peak number of live bytes is known.
+////////////////////////////////////////////////////////////////
+
+namespace
+{
+    constexpr size_t header = alignof(std::max_align_t);
+
+    std::atomic<size_t> live = 0;
+    std::atomic<size_t> peak = 0;
+
+    void* allocate(const size_t size)
+    {
+        auto* p = static_cast<char*>(std::malloc(size + header));
+        if (!p) throw std::bad_alloc();
+        std::memcpy(p, &size, sizeof(size));
+
+        const auto now = live.fetch_add(size, std::memory_order_relaxed) + size;
+        auto       old = peak.load(std::memory_order_relaxed);
+        while (now > old && !peak.compare_exchange_weak(old, now, std::memory_order_relaxed)) {}
+        return p + header;
+    }
+
+    void deallocate(void* ptr) noexcept
+    {
+        if (!ptr) return;
+        auto*  p = static_cast<char*>(ptr) - header;
+        size_t size;
+        std::memcpy(&size, p, sizeof(size));
+        live.fetch_sub(size, std::memory_order_relaxed);
+        std::free(p);
+    }
+}  // namespace
+
+void* operator new(const size_t size) { return allocate(size); }
+
+void* operator new[](const size_t size) { return allocate(size); }
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { deallocate(ptr); }
+
+void operator delete[](void* ptr, size_t) noexcept { deallocate(ptr); }
+
+namespace
+{
+    int failures = 0;
+
+    void check(const bool condition, const std::string& what)
+    {
+        if (condition) return;
+        std::cout << "FAILED: " << what << std::endl;
+        failures++;
+    }
+
+    /**
+     * \brief Growth of the input between the two measurements of a case.
+     */
+    constexpr size_t growth = 8;
+
+    /**
+     * \brief Maximum growth of time and memory when the input grows by the factor above. Linear cost grows by 8,
+     * quadratic cost by 64. Time has a larger margin, because the smaller input may still fit in the caches.
+     */
+    constexpr double max_time_growth   = 24.0;
+    constexpr double max_memory_growth = 16.0;
+
+    /**
+     * \brief If parsing the smaller input takes less time, timings are too noisy to compare. Pass a larger size to
+     * check the time of such cases.
+     */
+    constexpr auto min_duration = std::chrono::milliseconds(1);
+
+    struct measurement
+    {
+        std::chrono::nanoseconds time{0};
+        size_t                   bytes = 0;
+    };
+
+    /**
+     * \brief Create a parser with one argument of every kind that the adversarial inputs target.
+     */
+    pt::parser make_parser()
+    {
+        auto parser = pt::parser(0, nullptr, true);
+        parser.set_abbreviations(true);
+        parser.add_flag('a', "flag");
+        parser.add_flag('b', "verbose");
+        parser.add_value<std::string>('n', "name");
+        parser.add_value<int32_t>('c', "count");
+        parser.add_list<int32_t>('l', "list");
+        parser.add_list<int64_t>('i', "ids");
+        parser.add_list<int64_t, pt::set_storage>('s', "set");
+        parser.add_map<std::string, int32_t>('m', "map");
+        parser.add_map<uint64_t, int32_t>('k', "keys");
+        // Many long names that share a prefix, to stress abbreviation lookups.
+        for (size_t i = 0; i < 26 * 26; i++)
+        {
+            const char suffix[] = {static_cast<char>('a' + i / 26), static_cast<char>('a' + i % 26), '\0'};
+            parser.add_flag('\0', std::format("option{0}", suffix));
+        }
+        return parser;
+    }
+
+    /**
+     * \brief Parse the input once, measuring the time and the peak memory of constructing and running the parser.
+     */
+    measurement run(const std::function<void(pt::parser&)>& parse)
+    {
+        const auto base = live.load();
+        peak.store(base);
+        const auto start = std::chrono::steady_clock::now();
+        {
+            auto parser = make_parser();
+            parse(parser);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return {.time = end - start, .bytes = peak.load() - base};
+    }
+
+    /**
+     * \brief Best of three runs, to filter out scheduling noise.
+     */
+    measurement measure(const std::function<void(pt::parser&)>& parse)
+    {
+        measurement best = run(parse);
+        for (size_t i = 1; i < 3; i++)
+        {
+            const auto m = run(parse);
+            best.time    = std::min(best.time, m.time);
+            best.bytes   = std::min(best.bytes, m.bytes);
+        }
+        return best;
+    }
+
+    /**
+     * \brief Parse arguments with the parser.
+     */
+    std::function<void(pt::parser&)> arguments(std::vector<std::string> args)
+    {
+        return [args = std::move(args)](pt::parser& parser) {
+            parser.reset(args);
+            std::string e;
+            check(parser(e), "run");
+        };
+    }
+
+    /**
+     * \brief Feed a string to a push parser in fragments of 4 KiB.
+     */
+    std::function<void(pt::parser&)> fragments(std::string input)
+    {
+        return [input = std::move(input)](pt::parser& parser) {
+            pt::push_parser push(parser);
+            std::string     e;
+            for (size_t i = 0; i < input.size(); i += 4096)
+                check(push.feed(std::string_view(input).substr(i, 4096), e), "feed");
+            check(push.finish(e), "finish");
+        };
+    }
+
+    std::string repeat(const std::string& s, const size_t n)
+    {
+        std::string r;
+        r.reserve(s.size() * n);
+        for (size_t i = 0; i < n; i++) r += s;
+        return r;
+    }
+
+    /**
+     * \brief Distinct integers in descending order, so that no element can be appended to the sorted ones.
+     */
+    std::string descending(const size_t n)
+    {
+        std::string r;
+        for (size_t i = n; i > 0; i--) r += std::format("{0},", i);
+        return r;
+    }
+
+    /**
+     * \brief Distinct integer keys that differ only above the low 24 bits, to defeat hashes that keep the low bits.
+     */
+    std::string strided_keys(const size_t n)
+    {
+        std::string r;
+        for (uint64_t i = 0; i < n; i++) r += std::format("{0}=1,", i << 24);
+        return r;
+    }
+
+    /**
+     * \brief Add flags whose long names share a prefix, one for every 16 tokens, and pass ambiguous abbreviations of
+     * them, so that both the number of names and the number of lookups grow with the input.
+     */
+    std::function<void(pt::parser&)> shared_prefix(const size_t n)
+    {
+        return [n](pt::parser& parser) {
+            for (size_t i = 0; i < n / 16; i++)
+            {
+                // Long names consist of letters, so the index is written in base 26.
+                std::string name = "shared";
+                for (auto j = i; j > 0 || name.size() == 6; j /= 26) name += static_cast<char>('a' + j % 26);
+                parser.add_flag('\0', name);
+            }
+            arguments(std::vector<std::string>(n, "--sha"))(parser);
+        };
+    }
+
+    struct stress_case
+    {
+        std::string                                                   name;
+        std::function<std::function<void(pt::parser&)>(size_t size)> input;
+    };
+
+    const std::vector<stress_case> cases = {
+      {"tokens", [](const size_t n) { return arguments(std::vector<std::string>(n, "-a")); }},
+      {"operands", [](const size_t n) { return arguments(std::vector<std::string>(n, "x")); }},
+      {"unknown long names", [](const size_t n) { return arguments(std::vector<std::string>(n, "--unknown")); }},
+      {"abbreviated long names", [](const size_t n) { return arguments(std::vector<std::string>(n, "--verb")); }},
+      {"ambiguous long names", [](const size_t n) { return arguments(std::vector<std::string>(n, "--opt")); }},
+      {"many long names", [](const size_t n) { return shared_prefix(n); }},
+      {"long token", [](const size_t n) { return arguments({"--name=" + std::string(n, 'x')}); }},
+      {"flag cluster", [](const size_t n) { return arguments({"-" + repeat("az", n / 2)}); }},
+      {"flag with =", [](const size_t n) { return arguments({"--flag" + std::string(n, '=')}); }},
+      {"list elements", [](const size_t n) { return arguments({"--list=" + repeat("7,", n)}); }},
+      {"invalid list elements", [](const size_t n) { return arguments(std::vector<std::string>(n, "--list=x")); }},
+      {"ranges", [](const size_t n) { return arguments({"--ids=" + repeat("0-1000000000,", n)}); }},
+      {"set elements", [](const size_t n) { return arguments({"--set=" + repeat("1-4,", n)}); }},
+      {"descending set", [](const size_t n) { return arguments({"--set=" + descending(n)}); }},
+      {"map pairs", [](const size_t n) { return arguments({"--map=" + repeat("k=1,", n)}); }},
+      {"strided map keys", [](const size_t n) { return arguments({"--keys=" + strided_keys(n)}); }},
+      {"push tokens", [](const size_t n) { return fragments(repeat("-a ", n)); }},
+      {"push quotes", [](const size_t n) { return fragments("--name \"" + repeat("\\\" '", n) + "\""); }},
+    };
+}  // namespace
+
+int main(const int argc, char** argv)
+{
+    // The largest input size can be passed on the command line. The default is 2^18 tokens, elements or bytes, which
+    // keeps the test within seconds in an optimised build.
+    size_t size = size_t{1} << 18;
+    if (argc > 1)
+    {
+        const auto* end      = argv[1] + std::strlen(argv[1]);
+        const auto [ptr, ec] = std::from_chars(argv[1], end, size);
+        if (ec != std::errc() || ptr != end || size < growth)
+        {
+            std::cout << "Usage: stress_test [size]" << std::endl;
+            return 2;
+        }
+    }
+
+    // The cost of creating the parser does not depend on the input, so it is subtracted before comparing.
+    const auto empty = measure(arguments({}));
+
+    for (const auto& c : cases)
+    {
+        auto small = measure(c.input(size / growth));
+        auto large = measure(c.input(size));
+        small.time -= std::min(small.time, empty.time);
+        large.time -= std::min(large.time, empty.time);
+        small.bytes -= std::min(small.bytes, empty.bytes);
+        large.bytes -= std::min(large.bytes, empty.bytes);
+
+        const auto time_growth =
+          static_cast<double>(large.time.count()) / static_cast<double>(std::max<int64_t>(small.time.count(), 1));
+        const auto memory_growth =
+          static_cast<double>(large.bytes) / static_cast<double>(std::max<size_t>(small.bytes, 1));
+        std::cout << std::format("{0:<24} {1:>10.3f}ms {2:>12}B  time x{3:.1f}  memory x{4:.1f}",
+                                 c.name,
+                                 std::chrono::duration<double, std::milli>(large.time).count(),
+                                 large.bytes,
+                                 time_growth,
+                                 memory_growth)
+                  << std::endl;
+
+        if (small.time >= min_duration)
+            check(time_growth <= max_time_growth, c.name + ": time grows super-linearly");
+        check(memory_growth <= max_memory_growth, c.name + ": memory grows super-linearly");
+    }
+
+    if (failures == 0) std::cout << "All tests passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}